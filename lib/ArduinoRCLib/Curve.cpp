@@ -80,6 +80,29 @@ const int16_t& Curve::operator[](uint8_t p_index) const
 
 int16_t Curve::apply(int16_t p_value) const
 {
+	return writeInputValue(interpolate(p_value));
+}
+
+
+int16_t Curve::apply() const
+{
+	if (m_source != Input_None)
+	{
+		return apply(rc::getInput(m_source));
+	}
+	return 0;
+}
+
+
+// Private functions
+
+int16_t Curve::interpolate(int16_t p_value) const
+{
+	if (p_value < -256)
+	{
+		// would index before the first point, above 256 the last point is used already
+		p_value = -256;
+	}
 	p_value += 256; // range [0 - 512]
 	int16_t index = p_value >> 6;   // divide by 64, range [0 - 8]
 	int16_t rem   = p_value & 0x3F; // remainder of division
@@ -92,17 +115,7 @@ int16_t Curve::apply(int16_t p_value) const
 	lowval  = lowval * (64 - rem);
 	highval = highval * rem;
 	
-	return writeInputValue((lowval + highval) >> 6); // weighted average
-}
-
-
-int16_t Curve::apply() const
-{
-	if (m_source != Input_None)
-	{
-		return apply(rc::getInput(m_source));
-	}
-	return 0;
+	return (lowval + highval) >> 6; // weighted average
 }
 
 
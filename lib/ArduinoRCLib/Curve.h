@@ -90,6 +90,14 @@ public:
 	int16_t apply() const;
 	
 private:
+	friend class Pipeline;
+	friend class TransferFunction;
+	
+	/*! \brief Interpolates between the curve points, without writing to the destination.
+	    \param p_value Source value, range [-256 - 256].
+	    \return curve applied p_value, range [-256 - 256].*/
+	int16_t interpolate(int16_t p_value) const;
+	
 	int16_t m_points[PointCount]; //!< Points
 };
 /** \example curve_example.pde
@@ -12,6 +12,7 @@
 ** -------------------------------------------------------------------------*/
 
 #include <Expo.h>
+#include <ExpoTable.h>
 
 
 namespace rc
@@ -33,15 +34,35 @@ static const uint8_t s_expoNeg[EXPO_POINTS] = {101, 128, 147, 161, 174, 185, 194
 Expo::Expo(int8_t p_expo, Input p_index)
 :
 InputModifier(p_index),
-m_expo(p_expo)
+m_expo(p_expo),
+m_useTable(false),
+m_table(0)
 {
 	
 }
 
 
+Expo::Expo(const Expo& p_rhs)
+:
+InputModifier(p_rhs.m_index),
+m_expo(p_rhs.m_expo),
+m_useTable(false),
+m_table(0)
+{
+	setUseTable(p_rhs.m_useTable);
+}
+
+
+Expo::~Expo()
+{
+	ExpoTable::release(m_table);
+}
+
+
 void Expo::set(int8_t p_expo)
 {
 	m_expo = p_expo;
+	updateTable();
 }
 
 
@@ -54,6 +75,7 @@ int8_t Expo::get() const
 Expo& Expo::operator = (int8_t p_rhs)
 {
 	m_expo = p_rhs;
+	updateTable();
 	return *this;
 }
 
@@ -62,6 +84,7 @@ Expo& Expo::operator = (const Expo& p_rhs)
 {
 	m_expo  = p_rhs.m_expo;
 	m_index = p_rhs.m_index;
+	updateTable();
 	return *this;
 }
 
@@ -86,13 +109,84 @@ const int8_t* Expo::operator & () const
 
 int16_t Expo::apply(int16_t p_value) const
 {
-	if (m_expo == 0)
+	if (m_table != 0 && m_table->m_expo == m_expo)
+	{
+		if (p_value >= 0)
+		{
+			if (p_value < ExpoTable::Size)
+			{
+				return m_table->m_values[p_value];
+			}
+		}
+		else if (p_value > -ExpoTable::Size)
+		{
+			return -static_cast<int16_t>(m_table->m_values[-p_value]);
+		}
+	}
+	
+	return interpolate(p_value, m_expo);
+}
+
+
+void Expo::apply() const
+{
+	if (m_index != Input_None)
+	{
+		rc::setInput(m_index, apply(rc::getInput(m_index)));
+	}
+}
+
+
+bool Expo::setUseTable(bool p_use)
+{
+	m_useTable = p_use;
+	if (p_use == false)
+	{
+		ExpoTable::release(m_table);
+		m_table = 0;
+	}
+	else if (m_table == 0)
+	{
+		m_table = ExpoTable::acquire(m_expo);
+	}
+	else
+	{
+		updateTable();
+	}
+	return m_table != 0;
+}
+
+
+bool Expo::getUseTable() const
+{
+	return m_table != 0;
+}
+
+
+// Private functions
+
+void Expo::updateTable()
+{
+	if (m_useTable == false || (m_table != 0 && m_table->m_expo == m_expo))
+	{
+		return;
+	}
+	
+	// release first, if nobody else uses the table it's regenerated in place
+	ExpoTable::release(m_table);
+	m_table = ExpoTable::acquire(m_expo);
+}
+
+
+int16_t Expo::interpolate(int16_t p_value, int8_t p_expo)
+{
+	if (p_expo == 0)
 	{
 		// early abort
 		return p_value;
 	}
 	
-	int8_t expo = m_expo;
+	int8_t expo = p_expo;
 	
 	// select the expo array
 	const uint8_t* exparr = expo > 0 ? s_expoPos : s_expoNeg;
@@ -129,14 +223,5 @@ int16_t Expo::apply(int16_t p_value) const
 }
 
 
-void Expo::apply() const
-{
-	if (m_index != Input_None)
-	{
-		rc::setInput(m_index, apply(rc::getInput(m_index)));
-	}
-}
-
-
 // namespace end
 }
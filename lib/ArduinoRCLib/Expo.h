@@ -22,6 +22,8 @@
 namespace rc
 {
 
+class ExpoTable;
+
 /*! 
  *  \brief     Class to encapsulate Expo functionality.
  *  \details   This class provides exponential transformation.
@@ -37,6 +39,13 @@ public:
 	    \param p_index Input index to use for input and output.*/
 	Expo(int8_t p_expo = 0, Input p_index = Input_None);
 	
+	/*! \brief Copy constructor, shares the lookup table of p_rhs.
+	    \param p_rhs Object to copy.*/
+	Expo(const Expo& p_rhs);
+	
+	/*! \brief Destructor, releases the lookup table.*/
+	~Expo();
+	
 	
 	/*! \brief Sets the expo.
 	    \param p_expo The expo to set, range [-100 - 100].*/
@@ -76,8 +85,35 @@ public:
 	/*! \brief Applies expo to the set input.*/
 	void apply() const;
 	
+	/*! \brief Sets whether to use a lookup table, which makes apply() a single table lookup.
+	    \details The table is taken from the ExpoTable cache, which is empty unless EXPOTABLE_CACHE_SIZE
+	             is defined for the build. It is regenerated by set() and the assignment
+	             operators whenever the expo changes. Expo objects with the same expo share a table.
+	             After writing the expo through operator &, call set() to update the table,
+	             until then apply() interpolates.
+	    \param p_use Whether to use a lookup table.
+	    \return Whether a table is in use, false if the cache is full or disabled.*/
+	bool setUseTable(bool p_use);
+	
+	/*! \brief Gets whether a lookup table is in use.
+	    \return Whether apply() uses a lookup table.*/
+	bool getUseTable() const;
+	
 private:
-	int8_t m_expo;
+	friend class ExpoTable;
+	
+	/*! \brief Updates the lookup table after the expo changed.*/
+	void updateTable();
+	
+	/*! \brief Applies expo by interpolation.
+	    \param p_value Source value to apply expo to, range [-256 - 256].
+	    \param p_expo The expo, range [-100 - 100].
+	    \return expo applied to p_value.*/
+	static int16_t interpolate(int16_t p_value, int8_t p_expo);
+	
+	int8_t           m_expo;
+	bool             m_useTable; //!< Whether a lookup table should be used
+	const ExpoTable* m_table;    //!< Lookup table, 0 if not used or not available
 	
 };
 /** \example expo_example.pde
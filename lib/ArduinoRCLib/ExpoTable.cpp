@@ -0,0 +1,101 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** ExpoTable.cpp
+** Shared lookup tables for Expo
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Expo.h>
+#include <ExpoTable.h>
+
+
+namespace rc
+{
+
+#if EXPOTABLE_CACHE_SIZE > 0
+ExpoTable ExpoTable::s_cache[EXPOTABLE_CACHE_SIZE];
+#endif
+
+
+// Public functions
+
+const ExpoTable* ExpoTable::acquire(int8_t p_expo)
+{
+#if EXPOTABLE_CACHE_SIZE > 0
+	// share a table which already holds this expo, in use or not
+	ExpoTable* unused = 0;
+	for (uint8_t i = 0; i < EXPOTABLE_CACHE_SIZE; ++i)
+	{
+		ExpoTable& table = s_cache[i];
+		if (table.m_valid && table.m_expo == p_expo)
+		{
+			++table.m_users;
+			return &table;
+		}
+		if (table.m_users == 0 && (unused == 0 || unused->m_valid))
+		{
+			// prefer a table which was never generated, keep the others for later
+			unused = &table;
+		}
+	}
+	
+	if (unused == 0)
+	{
+		return 0;
+	}
+	
+	unused->m_expo = p_expo;
+	for (uint16_t value = 0; value < Size; ++value)
+	{
+		unused->m_values[value] = static_cast<uint8_t>(Expo::interpolate(static_cast<int16_t>(value), p_expo));
+	}
+	unused->m_valid = true;
+	unused->m_users = 1;
+	return unused;
+#else
+	(void)p_expo;
+	return 0;
+#endif
+}
+
+
+void ExpoTable::release(const ExpoTable* p_table)
+{
+	if (p_table != 0 && p_table->m_users != 0)
+	{
+		--const_cast<ExpoTable*>(p_table)->m_users;
+	}
+}
+
+
+int8_t ExpoTable::getExpo() const
+{
+	return m_expo;
+}
+
+
+uint8_t ExpoTable::lookup(uint8_t p_value) const
+{
+	return m_values[p_value];
+}
+
+
+// Private functions
+
+ExpoTable::ExpoTable()
+:
+m_expo(0),
+m_users(0),
+m_valid(false)
+{
+	
+}
+
+
+// namespace end
+}
@@ -0,0 +1,88 @@
+#ifndef INC_RC_EXPOTABLE_H
+#define INC_RC_EXPOTABLE_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** ExpoTable.h
+** Shared lookup tables for Expo
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+/* Opt-in: number of tables in the cache, each takes 259 bytes of RAM. Only Expo
+** objects with different expo values need a table of their own. The default of
+** 0 leaves the cache out, Expo::setUseTable() then returns false and apply()
+** interpolates. Define it for the whole build to use tables,
+** ie: build_flags = -DEXPOTABLE_CACHE_SIZE=2
+*/
+#ifndef EXPOTABLE_CACHE_SIZE
+#define EXPOTABLE_CACHE_SIZE 0
+#endif
+
+
+namespace rc
+{
+
+/*!
+ *  \brief     Class to hold the expo curve of a single expo value as a lookup table.
+ *  \details   The tables live in a cache of EXPOTABLE_CACHE_SIZE entries, Expo objects using the
+ *             same expo value share a table. A table holds the result of the expo interpolation for
+ *             every input value in [0 - 255], the result of 256 is always 256. The results fit in
+ *             8 bits, so a table takes 256 bytes instead of 514 for 16 bit entries.
+ *             Use Expo::setUseTable() rather than this class directly.
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ */
+class ExpoTable
+{
+public:
+	/*! \brief Nameless enum, magic number hiding. */
+	enum
+	{
+		Size = 256 //!< Number of entries, input values [0 - 255]
+	};
+	
+	/*! \brief Gets a table for an expo value, generates it if no table holds that expo yet.
+	    \param p_expo The expo, range [-100 - 100].
+	    \return The table, 0 if all tables in the cache are in use for other expo values or
+	            EXPOTABLE_CACHE_SIZE is 0.*/
+	static const ExpoTable* acquire(int8_t p_expo);
+	
+	/*! \brief Releases a table acquired before, the table may be reused for another expo value.
+	    \param p_table The table to release, may be 0.*/
+	static void release(const ExpoTable* p_table);
+	
+	/*! \brief Gets the expo value the table was generated for.
+	    \return The expo, range [-100 - 100].*/
+	int8_t getExpo() const;
+	
+	/*! \brief Looks up the expo result.
+	    \param p_value Source value, range [0 - 255].
+	    \return expo applied to p_value, range [0 - 255].*/
+	uint8_t lookup(uint8_t p_value) const;
+	
+private:
+	friend class Expo;
+	
+	ExpoTable();
+	
+	uint8_t m_values[Size]; //!< Results, indexed by source value
+	int8_t  m_expo;         //!< Expo value the table was generated for
+	uint8_t m_users;        //!< Number of acquire() calls not released yet
+	bool    m_valid;        //!< Whether the table has been generated
+	
+#if EXPOTABLE_CACHE_SIZE > 0
+	static ExpoTable s_cache[EXPOTABLE_CACHE_SIZE]; //!< All tables
+#endif
+};
+
+
+} // namespace end
+
+#endif // INC_RC_EXPOTABLE_H
@@ -69,6 +69,8 @@ public:
 	void apply() const;
 	
 private:
+	friend class Pipeline;
+	
 	int8_t m_mix; //!< Amount of mix to apply
 	bool   m_abs; //!< Whether to use absolute values for master.
 };
@@ -0,0 +1,178 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** IsrProfiler.cpp
+** Interrupt latency and duration measurement
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include <Arduino.h>
+#else
+	#include <avr/interrupt.h>
+	#include <wiring.h>
+#endif
+
+#include <IsrProfiler.h>
+
+#ifdef ISR_PROFILER
+
+
+namespace rc
+{
+
+static const char* const s_names[IsrProfiler::Vector_Count] =
+{
+	"PCINT",
+	"TIMER1_OVF",
+	"TIMER1_COMPA",
+	"TIMER1_COMPB",
+	"TIMER1_CAPT",
+	"TIMER2_COMPA"
+};
+
+
+IsrProfiler::Statistics IsrProfiler::s_statistics[IsrProfiler::Vector_Count];
+
+
+// Public functions
+
+void IsrProfiler::add(Vector p_vector, uint8_t p_duration, uint16_t p_latency)
+{
+	// called with interrupts disabled, from the end of an interrupt service routine
+	Statistics& stats = s_statistics[p_vector];
+	
+	if (stats.calls == 0)
+	{
+		stats.minDuration = p_duration;
+		stats.maxDuration = p_duration;
+		stats.minLatency  = p_latency;
+		stats.maxLatency  = 0;
+	}
+	if (stats.calls != 0xFFFF)
+	{
+		++stats.calls;
+	}
+	
+	if (p_duration < stats.minDuration)
+	{
+		stats.minDuration = p_duration;
+	}
+	if (p_duration > stats.maxDuration)
+	{
+		stats.maxDuration = p_duration;
+	}
+	
+	if (p_latency != ISR_PROFILE_NO_LATENCY)
+	{
+		if (p_latency < stats.minLatency)
+		{
+			stats.minLatency = p_latency;
+		}
+		if (p_latency > stats.maxLatency)
+		{
+			stats.maxLatency = p_latency;
+		}
+	}
+	
+	// bucket = number of significant bits of the duration
+	uint8_t bucket = 0;
+	while (p_duration != 0 && bucket < HistogramBuckets - 1)
+	{
+		p_duration >>= 1;
+		++bucket;
+	}
+	if (stats.histogram[bucket] != 0xFFFF)
+	{
+		++stats.histogram[bucket];
+	}
+}
+
+
+void IsrProfiler::get(Vector p_vector, Statistics& p_statisticsOUT)
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	p_statisticsOUT = s_statistics[p_vector];
+	SREG = oldSREG;
+}
+
+
+void IsrProfiler::reset()
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	for (uint8_t v = 0; v < Vector_Count; ++v)
+	{
+		Statistics& stats = s_statistics[v];
+		stats.calls = 0;
+		stats.minDuration = 0;
+		stats.maxDuration = 0;
+		stats.minLatency = ISR_PROFILE_NO_LATENCY;
+		stats.maxLatency = 0;
+		for (uint8_t i = 0; i < HistogramBuckets; ++i)
+		{
+			stats.histogram[i] = 0;
+		}
+	}
+	SREG = oldSREG;
+}
+
+
+uint16_t IsrProfiler::ticksToMicros(uint16_t p_ticks)
+{
+	return static_cast<uint16_t>((static_cast<uint32_t>(p_ticks) * ISR_PROFILER_CLOCK_PRESCALER) / (F_CPU / 1000000L));
+}
+
+
+void IsrProfiler::print(Print& p_output)
+{
+	for (uint8_t v = 0; v < Vector_Count; ++v)
+	{
+		Statistics stats;
+		get(static_cast<Vector>(v), stats);
+		if (stats.calls == 0)
+		{
+			continue;
+		}
+		
+		p_output.print(s_names[v]);
+		p_output.print(" calls=");
+		p_output.print(stats.calls);
+		p_output.print(" us=");
+		p_output.print(ticksToMicros(stats.minDuration));
+		p_output.print('/');
+		p_output.print(ticksToMicros(stats.maxDuration));
+		p_output.print(" latency=");
+		if (stats.minLatency == ISR_PROFILE_NO_LATENCY)
+		{
+			p_output.print('-');
+		}
+		else
+		{
+			p_output.print(stats.minLatency);
+			p_output.print('/');
+			p_output.print(stats.maxLatency);
+		}
+		p_output.print(" ticks=");
+		for (uint8_t i = 0; i < HistogramBuckets; ++i)
+		{
+			if (i != 0)
+			{
+				p_output.print(' ');
+			}
+			p_output.print(stats.histogram[i]);
+		}
+		p_output.println();
+	}
+}
+
+
+// namespace end
+}
+
+#endif // ISR_PROFILER
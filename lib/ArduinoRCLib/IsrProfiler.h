@@ -0,0 +1,132 @@
+#ifndef INC_RC_ISRPROFILER_H
+#define INC_RC_ISRPROFILER_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** IsrProfiler.h
+** Interrupt latency and duration measurement
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+#include <IsrProfile.h>
+
+/* Opt-in: define ISR_PROFILER for the whole build (all libraries, not just the
+** sketch), ie: build_flags = -DISR_PROFILER. Without it the macros are the empty
+** ones of IsrProfile.h and IsrProfiler does not exist, nothing is left in the
+** firmware.
+**
+** Instrumented interrupt service routines call ISR_PROFILE_BEGIN as their first
+** and ISR_PROFILE_END as their last statement. The duration between the two is
+** measured with ISR_PROFILER_CLOCK, an 8 bit timer count: by default TCNT0,
+** which Arduino runs at F_CPU / 64 (4 us at 16 MHz). Define ISR_PROFILER_CLOCK
+** and ISR_PROFILER_CLOCK_PRESCALER for a finer clock, ie: TCNT1 with 8 when
+** Timer1 runs as a free 0.5 us time base. The interrupt prologue and epilogue
+** are not included.
+**
+** The latency is how late the routine started after its event, in us. Only
+** timer interrupts know when their event happened (the compare or capture
+** value), pin change interrupts pass ISR_PROFILE_NO_LATENCY.
+*/
+#ifdef ISR_PROFILER
+
+#ifndef ISR_PROFILER_CLOCK
+#define ISR_PROFILER_CLOCK() TCNT0
+#define ISR_PROFILER_CLOCK_PRESCALER 64
+#endif
+
+#define ISR_PROFILE_BEGIN(p_latency) \
+	const uint8_t isrProfileStart = ISR_PROFILER_CLOCK(); \
+	const uint16_t isrProfileLatency = (p_latency)
+
+#define ISR_PROFILE_END(p_vector) \
+	rc::IsrProfiler::add(rc::IsrProfiler::p_vector, \
+	                     static_cast<uint8_t>(ISR_PROFILER_CLOCK() - isrProfileStart), \
+	                     isrProfileLatency)
+
+class Print;
+
+
+namespace rc
+{
+
+/*!
+ *  \brief     Class to collect latency and duration statistics of interrupt service routines.
+ *  \details   For every instrumented vector it counts the calls, keeps the minimum and maximum
+ *             duration and latency, and a histogram of the duration with power of two buckets:
+ *             bucket 0 counts routines shorter than one clock tick, bucket n those of
+ *             [2^(n-1) - 2^n) ticks, the last bucket all longer ones.
+ *             Adding a measurement takes a few dozen cycles, reading is done with interrupts
+ *             disabled per vector.
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ */
+class IsrProfiler
+{
+public:
+	enum Vector //! Instrumented interrupt vectors
+	{
+		Vector_PinChange,      //!< Pin change interrupts, all ports (PinChangeInt, RcReceiverPort)
+		Vector_Timer1Overflow, //!< TIMER1_OVF_vect
+		Vector_Timer1CompareA, //!< TIMER1_COMPA_vect
+		Vector_Timer1CompareB, //!< TIMER1_COMPB_vect
+		Vector_Timer1Capture,  //!< TIMER1_CAPT_vect
+		Vector_Timer2CompareA, //!< TIMER2_COMPA_vect
+		
+		Vector_Count
+	};
+	
+	static const uint8_t HistogramBuckets = 8;
+	
+	struct Statistics //! Measurements of a single vector
+	{
+		uint16_t calls;                        //!< Number of calls, saturates at 0xFFFF
+		uint8_t  minDuration;                  //!< Shortest routine, in clock ticks
+		uint8_t  maxDuration;                  //!< Longest routine, in clock ticks
+		uint16_t minLatency;                   //!< Shortest latency, in us, 0xFFFF if unknown
+		uint16_t maxLatency;                   //!< Longest latency, in us
+		uint16_t histogram[HistogramBuckets];  //!< Duration histogram, see class details
+	};
+	
+	/*! \brief Adds a measurement, called by ISR_PROFILE_END.
+	    \param p_vector The vector measured.
+	    \param p_duration Duration in clock ticks.
+	    \param p_latency Latency in us, ISR_PROFILE_NO_LATENCY if unknown.*/
+	static void add(Vector p_vector, uint8_t p_duration, uint16_t p_latency);
+	
+	/*! \brief Gets a consistent copy of the measurements of a vector.
+	    \param p_vector The vector to get.
+	    \param p_statisticsOUT The measurements.*/
+	static void get(Vector p_vector, Statistics& p_statisticsOUT);
+	
+	/*! \brief Clears the measurements of all vectors.*/
+	static void reset();
+	
+	/*! \brief Converts clock ticks to us.
+	    \param p_ticks Number of ISR_PROFILER_CLOCK ticks.
+	    \return p_ticks in us, rounded down.*/
+	static uint16_t ticksToMicros(uint16_t p_ticks);
+	
+	/*! \brief Writes the measurements of all vectors that were called as text, one line per vector.
+	    \param p_output Where to write to, ie: Serial.*/
+	static void print(Print& p_output);
+	
+private:
+	static Statistics s_statistics[Vector_Count]; //!< Measurements per vector
+};
+/** \example isrprofiler_example.pde
+ * This is an example of how to use the IsrProfiler class.
+ */
+
+
+} // namespace end
+
+#endif // ISR_PROFILER
+
+#endif // INC_RC_ISRPROFILER_H
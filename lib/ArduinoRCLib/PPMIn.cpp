@@ -20,6 +20,7 @@
 
 #include <PPMIn.h>
 #include <Timer1.h>
+#include <Timer1Arbiter.h>
 
 
 namespace rc
@@ -46,12 +47,18 @@ m_high(false)
 }
 
 
-void PPMIn::start(bool p_high)
+bool PPMIn::start(bool p_high)
 {
+	if (rc::Timer1Arbiter::acquire(rc::Timer1Arbiter::Client_PPMIn, rc::Timer1Arbiter::Resource_TimeBase) == false)
+	{
+		return false;
+	}
+	
 	m_high = p_high;
 	
 	// check if Timer 1 is running or not
 	rc::Timer1::start();
+	return true;
 }
 
 
@@ -48,9 +48,10 @@ public:
 	          the p_high parameter will make the interrupt handler respond to either
 	          the high or low pin change and may thus reduce problems created by
 	          simultaneous interrupts.
+	    \return Whether the Timer1 time base could be acquired, see Timer1Arbiter.
 	    \warning Do <b>NOT</b> use this together with the standard Arduino Servo library,
 	             use rc::ServoOut instead.*/
-	void start(bool p_high = false);
+	bool start(bool p_high = false);
 	
 	/*! \brief Sets minimum pause length, including pulse, in microseconds.
 	    \param p_length Minimum pause length in microseconds.*/
@@ -21,6 +21,7 @@
 
 #include <PPMOut.h>
 #include <Timer1.h>
+#include <Timer1Arbiter.h>
 
 
 namespace rc
@@ -48,10 +49,22 @@ m_timings(const_cast<uint16_t*>(m_channelTimings) + p_maxChannels)
 }
 
 
-void PPMOut::start(uint8_t p_pin, bool p_invert)
+bool PPMOut::start(uint8_t p_pin, bool p_invert)
 {
-	// stop timer 1
-	rc::Timer1::stop();
+	// pin 10 is toggled by compare unit B
+	uint8_t resources = rc::Timer1Arbiter::Resource_TimeBase | rc::Timer1Arbiter::Resource_CompareA;
+	if (p_pin == 10)
+	{
+		resources |= rc::Timer1Arbiter::Resource_CompareB;
+	}
+	if (rc::Timer1Arbiter::acquire(rc::Timer1Arbiter::Client_PPMOut, resources) == false)
+	{
+		return false;
+	}
+	
+	// the time base may be shared, so don't stop it; keep the interrupts away instead
+	uint8_t oldSREG = SREG;
+	cli();
 	
 	// Fill channelTimings buffer with data from channels buffer
 	update();
@@ -86,6 +99,9 @@ void PPMOut::start(uint8_t p_pin, bool p_invert)
 	
 	// start the timer
 	rc::Timer1::start();
+	
+	SREG = oldSREG;
+	return true;
 }
 
 
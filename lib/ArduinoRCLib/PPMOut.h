@@ -49,8 +49,9 @@ public:
 	    \param p_pin Pin to use as output pin, pins 9 and 10 are preferred and give the best result.
 	    \param p_invert Invert the signal on true.
 	    \note If precise timing is of importance then you should use either pin 9 or 10,
-		      these can be toggled by the timer hardware and will give the best results. */
-	void start(uint8_t p_pin, bool p_invert = false);
+		      these can be toggled by the timer hardware and will give the best results.
+	    \return Whether Timer1 compare unit A could be acquired, see Timer1Arbiter. */
+	bool start(uint8_t p_pin, bool p_invert = false);
 	
 	/*! \brief Sets channel count
 	    \param p_channels Channel count.*/
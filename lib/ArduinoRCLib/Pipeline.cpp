@@ -0,0 +1,358 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** Pipeline.cpp
+** Runs input stages in dependency order
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Curve.h>
+#include <DualRates.h>
+#include <Expo.h>
+#include <InputToInputMix.h>
+#include <Pipeline.h>
+#include <ThrottleHold.h>
+#include <util.h>
+
+
+namespace rc
+{
+
+// Public functions
+
+Pipeline::Pipeline()
+:
+m_count(0),
+m_compiled(0),
+m_dirty(false),
+m_full(true),
+m_reload(true),
+m_evaluated(0),
+m_skipped(0),
+m_reads(0),
+m_writes(0)
+{
+	
+}
+
+
+bool Pipeline::add(const DualRates& p_rates)
+{
+	return add(Opcode_DualRates, addressOf(p_rates), 0);
+}
+
+
+bool Pipeline::add(const Expo& p_expo)
+{
+	return add(Opcode_Expo, addressOf(p_expo), 0);
+}
+
+
+bool Pipeline::add(const Curve& p_curve)
+{
+	return add(Opcode_Curve, addressOf(p_curve), 0);
+}
+
+
+bool Pipeline::add(const InputToInputMix& p_mix)
+{
+	return add(Opcode_Mix, addressOf(p_mix), 0);
+}
+
+
+bool Pipeline::add(const ThrottleHold& p_hold, const bool& p_enabled)
+{
+	return add(Opcode_Hold, addressOf(p_hold), &p_enabled);
+}
+
+
+void Pipeline::clear()
+{
+	m_count    = 0;
+	m_compiled = 0;
+	m_dirty    = false;
+	m_reads    = 0;
+	m_writes   = 0;
+	m_full     = true;
+	m_reload   = true;
+}
+
+
+bool Pipeline::compile()
+{
+	m_dirty    = false;
+	m_full     = true;
+	m_reload   = true;
+	m_compiled = 0;
+	m_reads    = 0;
+	m_writes   = 0;
+	
+	// fetch the input indices from the objects
+	uint16_t active = 0;
+	for (uint8_t i = 0; i < m_count; ++i)
+	{
+		Stage& stage = m_stages[i];
+		Input source;
+		Input destination;
+		switch (stage.opcode)
+		{
+			case Opcode_DualRates:
+				source = destination = static_cast<const DualRates*>(stage.object)->getIndex();
+			break;
+			
+			case Opcode_Expo:
+				source = destination = static_cast<const Expo*>(stage.object)->getIndex();
+			break;
+			
+			case Opcode_Curve:
+				source      = static_cast<const Curve*>(stage.object)->getSource();
+				destination = static_cast<const Curve*>(stage.object)->getDestination();
+			break;
+			
+			case Opcode_Mix:
+				source      = static_cast<const InputToInputMix*>(stage.object)->getSource();
+				destination = static_cast<const InputToInputMix*>(stage.object)->getIndex();
+			break;
+			
+			case Opcode_Hold:
+			default:
+				source = destination = static_cast<const ThrottleHold*>(stage.object)->getIndex();
+			break;
+		}
+		stage.source      = static_cast<uint8_t>(source);
+		stage.destination = static_cast<uint8_t>(destination);
+		
+		if (source < Input_Count && destination < Input_Count)
+		{
+			active |= static_cast<uint16_t>(1) << i;
+		}
+	}
+	
+	// stage i has to run before stage j if both write the same input and i was added first,
+	// or if j reads the input i writes (and doesn't write it itself)
+	uint16_t before[MaxStages];
+	for (uint8_t j = 0; j < m_count; ++j)
+	{
+		before[j] = 0;
+		for (uint8_t i = 0; i < m_count; ++i)
+		{
+			if (i == j || (active & (static_cast<uint16_t>(1) << i)) == 0)
+			{
+				continue;
+			}
+			const Stage& first  = m_stages[i];
+			const Stage& second = m_stages[j];
+			if (first.destination == second.destination ? i < j : first.destination == second.source)
+			{
+				before[j] |= static_cast<uint16_t>(1) << i;
+			}
+		}
+	}
+	
+	// repeatedly take the first stage of which all predecessors have been taken
+	uint16_t done  = 0;
+	uint8_t  count = 0;
+	while (done != active)
+	{
+		uint8_t next = 0;
+		while (next < m_count &&
+		       ((active & ~done & (static_cast<uint16_t>(1) << next)) == 0 || (before[next] & ~done) != 0))
+		{
+			++next;
+		}
+		if (next == m_count)
+		{
+			// the remaining stages wait for each other, don't run the ones sorted so far either
+			m_reads  = 0;
+			m_writes = 0;
+			return false;
+		}
+		m_order[count] = next;
+		++count;
+		done |= static_cast<uint16_t>(1) << next;
+		
+		const Stage& stage = m_stages[next];
+		m_reads  |= static_cast<uint16_t>(1) << stage.source;
+		m_writes |= static_cast<uint16_t>(1) << stage.destination;
+		if (stage.opcode != Opcode_Curve)
+		{
+			// all others modify their destination
+			m_reads |= static_cast<uint16_t>(1) << stage.destination;
+		}
+	}
+	
+	m_compiled = count;
+	return true;
+}
+
+
+uint8_t Pipeline::getStageCount() const
+{
+	return m_count;
+}
+
+
+uint8_t Pipeline::getCompiledCount() const
+{
+	return m_compiled;
+}
+
+
+void Pipeline::invalidate()
+{
+	m_full = true;
+}
+
+
+void Pipeline::run()
+{
+	if (m_dirty)
+	{
+		compile();
+	}
+	
+	// Only inputs which are dirty may have changed. The inputs this pipeline writes hold the results
+	// of the last run, unless written by someone else since, m_inputs holds the values before processing.
+	uint16_t dirty   = m_reload ? m_reads : (rc::getDirtyInputs() & m_reads);
+	uint16_t changed = 0;
+	int16_t values[Input_Count];
+	for (uint8_t i = 0; i < Input_Count; ++i)
+	{
+		uint16_t bit = static_cast<uint16_t>(1) << i;
+		if (dirty & bit)
+		{
+			int16_t value = rc::getInput(static_cast<Input>(i));
+			if (m_reload || value != m_inputs[i])
+			{
+				m_inputs[i] = value;
+				changed |= bit;
+			}
+		}
+		if (m_reads & bit)
+		{
+			values[i] = m_inputs[i];
+		}
+	}
+	
+	m_evaluated = 0;
+	m_skipped   = 0;
+	for (uint8_t i = 0; i < m_compiled; ++i)
+	{
+		const Stage& stage = m_stages[m_order[i]];
+		uint16_t destination = static_cast<uint16_t>(1) << stage.destination;
+		uint16_t sources     = static_cast<uint16_t>(1) << stage.source;
+		if (stage.opcode != Opcode_Curve)
+		{
+			sources |= destination;
+		}
+		
+		if (m_full == false && (changed & sources) == 0 && stage.opcode != Opcode_Hold)
+		{
+			// nothing this stage reads changed, neither did its result
+			values[stage.destination] = m_results[i];
+			changed &= ~destination;
+			++m_skipped;
+			continue;
+		}
+		
+		int16_t value = values[stage.source];
+		
+		switch (stage.opcode)
+		{
+			case Opcode_DualRates:
+				value = static_cast<const DualRates*>(stage.object)->apply(value);
+			break;
+			
+			case Opcode_Expo:
+				value = static_cast<const Expo*>(stage.object)->apply(value);
+			break;
+			
+			case Opcode_Curve:
+				value = static_cast<const Curve*>(stage.object)->interpolate(value);
+			break;
+			
+			case Opcode_Mix:
+				value = static_cast<const InputToInputMix*>(stage.object)->apply(value, values[stage.destination]);
+			break;
+			
+			case Opcode_Hold:
+				value = static_cast<const ThrottleHold*>(stage.object)->apply(*stage.enabled, value);
+			break;
+			
+			default:
+			break;
+		}
+		++m_evaluated;
+		
+		// stages further down only have to run if the result changed
+		if (m_full || value != m_results[i])
+		{
+			m_results[i] = value;
+			changed |= destination;
+		}
+		else
+		{
+			changed &= ~destination;
+		}
+		values[stage.destination] = value;
+	}
+	
+	// write all results, the source of an input which is modified in place may have overwritten it
+	// with an unchanged value, setInput only marks the inputs which really change
+	for (uint8_t i = 0; i < Input_Count; ++i)
+	{
+		if (m_writes & (static_cast<uint16_t>(1) << i))
+		{
+			rc::setInput(static_cast<Input>(i), values[i]);
+		}
+	}
+	rc::clearDirtyInputs(m_reads | m_writes);
+	
+	// inputs modified in place hold the result now, the next write of the raw value has to count as
+	// a change, even if it happens to be the same as the result
+	rc::markInputsProcessed(m_reads & m_writes);
+	m_full   = false;
+	m_reload = false;
+}
+
+
+uint8_t Pipeline::getEvaluatedCount() const
+{
+	return m_evaluated;
+}
+
+
+uint8_t Pipeline::getSkippedCount() const
+{
+	return m_skipped;
+}
+
+
+// Private functions
+
+bool Pipeline::add(Opcode p_opcode, const void* p_object, const bool* p_enabled)
+{
+	if (m_count >= MaxStages)
+	{
+		return false;
+	}
+	
+	Stage& stage = m_stages[m_count];
+	stage.opcode      = static_cast<uint8_t>(p_opcode);
+	stage.source      = Input_None;
+	stage.destination = Input_None;
+	stage.object      = p_object;
+	stage.enabled     = p_enabled;
+	++m_count;
+	
+	m_dirty = true;
+	return true;
+}
+
+
+// namespace end
+}
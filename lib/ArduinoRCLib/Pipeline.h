@@ -0,0 +1,163 @@
+#ifndef INC_RC_PIPELINE_H
+#define INC_RC_PIPELINE_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** Pipeline.h
+** Runs input stages in dependency order
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+#include <input.h>
+
+
+namespace rc
+{
+
+class Curve;
+class DualRates;
+class Expo;
+class InputToInputMix;
+class ThrottleHold;
+
+/*!
+ *  \brief     Class to run DualRates, Expo, Curve, InputToInputMix and ThrottleHold stages in one go.
+ *  \details   Instead of calling apply() on every object in the right order, add the objects to a
+ *             Pipeline and call run() once per frame. compile() sorts the stages by the inputs they
+ *             read and write into a flat array of operations:
+ *             - stages writing the same input run in the order they were added,
+ *             - a stage reading an input runs after all stages writing that input.
+ *             run() loads the inputs used once, executes the operations in a single loop on a local
+ *             copy and writes back the inputs changed. There are no virtual calls and no
+ *             getInput/setInput round trips per stage.
+ *             Evaluation is incremental: a stage only runs when one of the inputs it reads was
+ *             changed, either by setInput (see getDirtyInputs) or by an earlier stage. Stages whose
+ *             result did not change stop the propagation, the others reuse their last result.
+ *             Throttle hold stages always run, their switch is not an input.
+ *             The pipeline clears the dirty flags of the inputs it uses, so don't let two pipelines
+ *             share an input.
+ *             The objects are referenced, not copied: after changing a rate, expo or curve point
+ *             call invalidate(), so the next run() evaluates all stages. Changing an input index of
+ *             an added object requires another compile().
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ */
+class Pipeline
+{
+public:
+	/*! \brief Nameless enum, magic number hiding. */
+	enum
+	{
+		MaxStages = 16 //!< Maximum number of stages in a pipeline
+	};
+	
+	/*! \brief Constructs an empty Pipeline object.*/
+	Pipeline();
+	
+	/*! \brief Adds a dual rates stage, applied to its index.
+	    \param p_rates The DualRates object, must outlive the pipeline.
+	    \return false if the pipeline is full.*/
+	bool add(const DualRates& p_rates);
+	
+	/*! \brief Adds an expo stage, applied to its index.
+	    \param p_expo The Expo object, must outlive the pipeline.
+	    \return false if the pipeline is full.*/
+	bool add(const Expo& p_expo);
+	
+	/*! \brief Adds a curve stage, from its source to its destination.
+	    \param p_curve The Curve object, must outlive the pipeline.
+	    \return false if the pipeline is full.*/
+	bool add(const Curve& p_curve);
+	
+	/*! \brief Adds a mix stage, from its source (master) into its index (slave).
+	    \param p_mix The InputToInputMix object, must outlive the pipeline.
+	    \return false if the pipeline is full.*/
+	bool add(const InputToInputMix& p_mix);
+	
+	/*! \brief Adds a throttle hold stage, applied to its index.
+	    \param p_hold The ThrottleHold object, must outlive the pipeline.
+	    \param p_enabled Whether throttle hold is enabled, read on every run.
+	    \return false if the pipeline is full.*/
+	bool add(const ThrottleHold& p_hold, const bool& p_enabled);
+	
+	/*! \brief Removes all stages.*/
+	void clear();
+	
+	/*! \brief Sorts the stages into execution order.
+	    \details Stages of which an input index is Input_None are skipped. Called by run() after
+	             stages were added, call it yourself after changing an input index.
+	    \return false if the stages depend on each other in a loop, nothing runs in that case.*/
+	bool compile();
+	
+	/*! \brief Gets the number of stages added.
+	    \return The number of stages, range [0 - MaxStages].*/
+	uint8_t getStageCount() const;
+	
+	/*! \brief Gets the number of stages run() executes.
+	    \return The number of compiled stages, range [0 - MaxStages].*/
+	uint8_t getCompiledCount() const;
+	
+	/*! \brief Makes the next run() evaluate all stages, call it after changing a parameter.*/
+	void invalidate();
+	
+	/*! \brief Runs the stages of which an input changed, reads from and writes to the input system.*/
+	void run();
+	
+	/*! \brief Gets the number of stages the last run() evaluated.
+	    \return The number of stages evaluated, range [0 - MaxStages].*/
+	uint8_t getEvaluatedCount() const;
+	
+	/*! \brief Gets the number of stages the last run() skipped, because none of their inputs changed.
+	    \return The number of stages skipped, range [0 - MaxStages].*/
+	uint8_t getSkippedCount() const;
+	
+private:
+	enum Opcode
+	{
+		Opcode_DualRates,
+		Opcode_Expo,
+		Opcode_Curve,
+		Opcode_Mix,
+		Opcode_Hold
+	};
+	
+	struct Stage //! A single operation
+	{
+		uint8_t     opcode;      //!< What to do, Opcode
+		uint8_t     source;      //!< Input to read, set by compile()
+		uint8_t     destination; //!< Input to write, set by compile()
+		const void* object;      //!< The object holding the parameters
+		const bool* enabled;     //!< Throttle hold switch, Opcode_Hold only
+	};
+	
+	bool add(Opcode p_opcode, const void* p_object, const bool* p_enabled);
+	
+	Stage    m_stages[MaxStages];    //!< Stages in the order they were added
+	uint8_t  m_order[MaxStages];     //!< Indices of the stages to run, in execution order
+	uint8_t  m_count;                //!< Number of stages added
+	uint8_t  m_compiled;             //!< Number of stages to run
+	bool     m_dirty;                //!< Stages were added since the last compile()
+	bool     m_full;                 //!< Evaluate all stages on the next run()
+	bool     m_reload;               //!< Fetch all inputs on the next run(), m_inputs is not valid
+	uint8_t  m_evaluated;            //!< Stages evaluated by the last run()
+	uint8_t  m_skipped;              //!< Stages skipped by the last run()
+	uint16_t m_reads;                //!< Inputs read by the compiled stages, one bit per Input
+	uint16_t m_writes;               //!< Inputs written by the compiled stages, one bit per Input
+	int16_t  m_inputs[Input_Count];  //!< Input values seen by the last run(), before processing
+	int16_t  m_results[MaxStages];   //!< Result of each compiled stage, in execution order
+};
+/** \example pipeline_example.pde
+ * This is an example of how to use the Pipeline class.
+ */
+
+
+} // namespace end
+
+#endif // INC_RC_PIPELINE_H
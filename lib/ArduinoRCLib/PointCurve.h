@@ -0,0 +1,340 @@
+#ifndef INC_RC_POINTCURVE_H
+#define INC_RC_POINTCURVE_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** PointCurve.h
+** Curve with a configurable number of points, linear or smooth
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+#include <Curve.h>
+#include <InputProcessor.h>
+#include <InputSource.h>
+
+
+namespace rc
+{
+
+/*!
+ *  \brief     Class to encapsulate a curve through PointCount points.
+ *  \details   Like Curve, but the number of points is a template parameter and the curve may be
+ *             smooth. The points are spread evenly over [-256 - 256].
+ *             apply() interpolates linearly in a table of TablePoints values, using the slope of
+ *             each segment in Q8 precomputed by setPoint(): one multiply-add per sample.
+ *             With Interpolation_Linear the table holds the straight lines between the points.
+ *             With Interpolation_Smooth it holds a monotone cubic spline through the points
+ *             (Fritsch-Carlson), which never overshoots: between two points the curve stays between
+ *             their values. Sampling the spline needs more table points than curve points, ie:
+ *             PointCurve<9, 65> is a 9 point curve sampled every 8 steps.
+ *             Both PointCount and TablePoints must be a power of two plus one, in [3 - 65].
+ *             RAM use is 2 * PointCount + 4 * TablePoints bytes.
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ */
+template <uint8_t PointCount, uint8_t TablePoints = PointCount>
+class PointCurve : public InputProcessor, InputSource
+{
+public:
+	enum Interpolation //! Interpolation between the points
+	{
+		Interpolation_Linear, //!< Straight lines between the points
+		Interpolation_Smooth  //!< Monotone cubic spline through the points
+	};
+	
+	/*! \brief Constructs a PointCurve object
+	    \param p_curve Default curve to initialize with.
+	    \param p_source Input source.
+	    \param p_destination Where results should be written to.*/
+	PointCurve(Curve::DefaultCurve p_curve = Curve::DefaultCurve_Linear,
+	           Input p_source = Input_None,
+	           Input p_destination = Input_None);
+	
+	/*! \brief Loads a default curve.
+	    \param p_curve Curve to load.*/
+	void loadCurve(Curve::DefaultCurve p_curve);
+	
+	/*! \brief Sets a curve point, updates the table.
+	    \param p_point The point to set, range [0 - PointCount-1].
+	    \param p_value The value to set, range [-256 - 256].*/
+	void setPoint(uint8_t p_point, int16_t p_value);
+	
+	/*! \brief Gets a curve point.
+	    \param p_point The point to get, range [0 - PointCount-1].
+	    \return The current value, range [-256 - 256].*/
+	int16_t getPoint(uint8_t p_point) const;
+	
+	/*! \brief Array subscript operator, read access to the curve points, use setPoint() to change them.
+	    \param p_point The point to get, range [0 - PointCount-1].
+	    \return Reference to point.*/
+	const int16_t& operator[](uint8_t p_point) const;
+	
+	/*! \brief Sets the interpolation between the points, updates the table.
+	    \param p_interpolation Interpolation to use.*/
+	void setInterpolation(Interpolation p_interpolation);
+	
+	/*! \brief Gets the interpolation between the points.
+	    \return The interpolation in use.*/
+	Interpolation getInterpolation() const;
+	
+	/*! \brief Applies curve.
+	    \param p_value Source value to apply curve to, range [-256 - 256].
+	    \return curve applied p_value, range [-256 - 256].*/
+	int16_t apply(int16_t p_value) const;
+	
+	/*! \brief Applies curve to configured input.
+	    \return curve applied p_value, range [-256 - 256].*/
+	int16_t apply() const;
+	
+private:
+	/*! \brief Nameless enum, magic number hiding. */
+	enum
+	{
+		PointShift = PointCount ==  3 ? 8 : PointCount ==  5 ? 7 : PointCount ==  9 ? 6 :
+		             PointCount == 17 ? 5 : PointCount == 33 ? 4 : PointCount == 65 ? 3 : 0,
+		TableShift = TablePoints ==  3 ? 8 : TablePoints ==  5 ? 7 : TablePoints ==  9 ? 6 :
+		             TablePoints == 17 ? 5 : TablePoints == 33 ? 4 : TablePoints == 65 ? 3 : 0
+	};
+	
+	static_assert(PointShift != 0, "PointCount must be 3, 5, 9, 17, 33 or 65");
+	static_assert(TableShift != 0, "TablePoints must be 3, 5, 9, 17, 33 or 65");
+	static_assert(TablePoints >= PointCount, "TablePoints must be at least PointCount");
+	
+	/*! \brief Calculates the table from the points.*/
+	void update();
+	
+	/*! \brief Calculates the value of the curve at a table point.
+	    \param p_x Position on the curve, range [0 - 512].
+	    \param p_tangents Tangents at the points, Interpolation_Smooth only.
+	    \return Value of the curve at p_x.*/
+	int16_t evaluate(uint16_t p_x, const int16_t* p_tangents) const;
+	
+	int16_t       m_points[PointCount];      //!< Points
+	int16_t       m_values[TablePoints];     //!< Curve value at each table point
+	int16_t       m_slopes[TablePoints - 1]; //!< Slope from each table point to the next, Q8 per step
+	Interpolation m_interpolation;           //!< Interpolation between the points
+};
+/** \example pointcurve_example.pde
+ * This is an example of how to use the PointCurve class.
+ */
+
+
+// Public functions
+
+template <uint8_t PointCount, uint8_t TablePoints>
+PointCurve<PointCount, TablePoints>::PointCurve(Curve::DefaultCurve p_curve,
+                                                Input p_source,
+                                                Input p_destination)
+:
+InputProcessor(p_source),
+InputSource(p_destination),
+m_interpolation(Interpolation_Linear)
+{
+	loadCurve(p_curve);
+}
+
+
+template <uint8_t PointCount, uint8_t TablePoints>
+void PointCurve<PointCount, TablePoints>::loadCurve(Curve::DefaultCurve p_curve)
+{
+	for (uint8_t i = 0; i < PointCount; ++i)
+	{
+		int16_t linear = static_cast<int16_t>((i << PointShift) - 256);
+		switch (p_curve)
+		{
+			case Curve::DefaultCurve_HalfLinear: m_points[i] = (linear + 256) >> 1;            break;
+			case Curve::DefaultCurve_V:          m_points[i] = linear < 0 ? -linear : linear; break;
+			case Curve::DefaultCurve_Linear:
+			default:                             m_points[i] = linear;                        break;
+		}
+	}
+	update();
+}
+
+
+template <uint8_t PointCount, uint8_t TablePoints>
+void PointCurve<PointCount, TablePoints>::setPoint(uint8_t p_point, int16_t p_value)
+{
+	if (p_point < PointCount)
+	{
+		m_points[p_point] = p_value;
+		update();
+	}
+}
+
+
+template <uint8_t PointCount, uint8_t TablePoints>
+int16_t PointCurve<PointCount, TablePoints>::getPoint(uint8_t p_point) const
+{
+	if (p_point < PointCount)
+	{
+		return m_points[p_point];
+	}
+	return 0;
+}
+
+
+template <uint8_t PointCount, uint8_t TablePoints>
+const int16_t& PointCurve<PointCount, TablePoints>::operator[](uint8_t p_point) const
+{
+	return m_points[p_point];
+}
+
+
+template <uint8_t PointCount, uint8_t TablePoints>
+void PointCurve<PointCount, TablePoints>::setInterpolation(Interpolation p_interpolation)
+{
+	m_interpolation = p_interpolation;
+	update();
+}
+
+
+template <uint8_t PointCount, uint8_t TablePoints>
+typename PointCurve<PointCount, TablePoints>::Interpolation PointCurve<PointCount, TablePoints>::getInterpolation() const
+{
+	return m_interpolation;
+}
+
+
+template <uint8_t PointCount, uint8_t TablePoints>
+int16_t PointCurve<PointCount, TablePoints>::apply(int16_t p_value) const
+{
+	if (p_value <= -256)
+	{
+		return writeInputValue(m_values[0]);
+	}
+	if (p_value >= 256)
+	{
+		return writeInputValue(m_values[TablePoints - 1]);
+	}
+	
+	uint16_t x     = static_cast<uint16_t>(p_value + 256); // range [1 - 511]
+	uint8_t  index = x >> TableShift;
+	uint8_t  rem   = x & ((1 << TableShift) - 1);
+	
+	// |slope| <= 2^14 and rem < 2^5, the product needs 32 bits
+	return writeInputValue(m_values[index] + static_cast<int16_t>((static_cast<int32_t>(m_slopes[index]) * rem) >> 8));
+}
+
+
+template <uint8_t PointCount, uint8_t TablePoints>
+int16_t PointCurve<PointCount, TablePoints>::apply() const
+{
+	if (m_source != Input_None)
+	{
+		return apply(rc::getInput(m_source));
+	}
+	return 0;
+}
+
+
+// Private functions
+
+template <uint8_t PointCount, uint8_t TablePoints>
+void PointCurve<PointCount, TablePoints>::update()
+{
+	int16_t tangents[PointCount];
+	if (m_interpolation == Interpolation_Smooth)
+	{
+		// Fritsch-Carlson: start with the average of the neighbouring secants, zero at extremes
+		// (in units of rise per segment, so the secant of a segment is the difference of its points)
+		for (uint8_t i = 0; i < PointCount; ++i)
+		{
+			// the end points only have one secant
+			int16_t left  = m_points[i == 0 ? 1 : i] - m_points[i == 0 ? 0 : i - 1];
+			int16_t right = m_points[i == PointCount - 1 ? i : i + 1] - m_points[i == PointCount - 1 ? i - 1 : i];
+			tangents[i] = (left > 0 && right > 0) || (left < 0 && right < 0) ? (left + right) / 2 : 0;
+		}
+		
+		// then limit the tangents to three times the secant, which keeps every segment monotone
+		for (uint8_t i = 0; i < PointCount - 1; ++i)
+		{
+			int16_t secant = m_points[i + 1] - m_points[i];
+			int16_t limit  = secant < 0 ? -3 * secant : 3 * secant;
+			for (uint8_t j = i; j <= i + 1; ++j)
+			{
+				if (tangents[j] > limit)
+				{
+					tangents[j] = limit;
+				}
+				else if (tangents[j] < -limit)
+				{
+					tangents[j] = -limit;
+				}
+			}
+		}
+	}
+	
+	for (uint8_t i = 0; i < TablePoints; ++i)
+	{
+		m_values[i] = evaluate(static_cast<uint16_t>(i) << TableShift, tangents);
+	}
+	for (uint8_t i = 0; i < TablePoints - 1; ++i)
+	{
+		// |difference| <= 512 and TableShift >= 3, so the slope fits in 16 bits
+		m_slopes[i] = (m_values[i + 1] - m_values[i]) * (1 << (8 - TableShift));
+	}
+}
+
+
+template <uint8_t PointCount, uint8_t TablePoints>
+int16_t PointCurve<PointCount, TablePoints>::evaluate(uint16_t p_x, const int16_t* p_tangents) const
+{
+	uint8_t index = p_x >> PointShift;
+	if (index >= PointCount - 1)
+	{
+		return m_points[PointCount - 1];
+	}
+	
+	int16_t  low  = m_points[index];
+	int16_t  high = m_points[index + 1];
+	uint16_t rem  = p_x & ((1 << PointShift) - 1);
+	
+	if (m_interpolation == Interpolation_Linear || rem == 0)
+	{
+		// same as Curve
+		return low + static_cast<int16_t>((static_cast<int32_t>(high - low) * rem) >> PointShift);
+	}
+	
+	// cubic Hermite in t = rem / segment width, in Q8
+	int32_t secant = high - low;
+	int32_t t1 = static_cast<int32_t>(rem) << (8 - PointShift);
+	int32_t t2 = (t1 * t1) >> 8;
+	int32_t t3 = (t2 * t1) >> 8;
+	int32_t m0 = p_tangents[index];
+	int32_t m1 = p_tangents[index + 1];
+	
+	int32_t value = (static_cast<int32_t>(low) << 8) +
+	                t1 * m0 +
+	                t2 * (3 * secant - 2 * m0 - m1) +
+	                t3 * (m0 + m1 - 2 * secant);
+	int16_t result = static_cast<int16_t>((value + 128) >> 8);
+	
+	// rounding must not break monotonicity: stay between the points and don't turn back
+	int16_t previous = m_values[((p_x >> TableShift) - 1)];
+	if (secant > 0)
+	{
+		result = result < previous ? previous : (result > high ? high : result);
+	}
+	else if (secant < 0)
+	{
+		result = result > previous ? previous : (result < high ? high : result);
+	}
+	else
+	{
+		result = low;
+	}
+	return result;
+}
+
+
+} // namespace end
+
+#endif // INC_RC_POINTCURVE_H
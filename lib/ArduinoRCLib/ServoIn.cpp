@@ -20,6 +20,7 @@
 
 #include <ServoIn.h>
 #include <Timer1.h>
+#include <Timer1Arbiter.h>
 
 
 namespace rc
@@ -39,8 +40,13 @@ m_pulseLength(m_pulseStart + p_maxServos)
 }
 
 
-void ServoIn::start(bool p_high)
+bool ServoIn::start(bool p_high)
 {
+	if (rc::Timer1Arbiter::acquire(rc::Timer1Arbiter::Client_ServoIn, rc::Timer1Arbiter::Resource_TimeBase) == false)
+	{
+		return false;
+	}
+	
 	m_high = p_high;
 	
 	// clean buffers
@@ -53,6 +59,7 @@ void ServoIn::start(bool p_high)
 	
 	// start Timer 1
 	rc::Timer1::start();
+	return true;
 }
 
 
@@ -43,9 +43,10 @@ public:
 	
 	/*! \brief Starts measuring.
 	    \param p_high Whether the incoming signal has high or low pulses.
+	    \return Whether the Timer1 time base could be acquired, see Timer1Arbiter.
 	    \warning Do <b>NOT</b> use this together with the standard Arduino Servo library,
 	             use rc::ServoOut instead.*/
-	void start(bool p_high = true);
+	bool start(bool p_high = true);
 	
 	/*! \brief Handles pin change interrupt, call in your interrupt handler.
 	    \param p_servo For which servo the pin changed.
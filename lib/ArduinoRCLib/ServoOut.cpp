@@ -21,6 +21,7 @@
 
 #include <ServoOut.h>
 #include <Timer1.h>
+#include <Timer1Arbiter.h>
 
 
 namespace rc
@@ -50,13 +51,20 @@ m_idx(0)
 }
 
 
-void ServoOut::start()
+bool ServoOut::start()
 {
+	if (rc::Timer1Arbiter::acquire(rc::Timer1Arbiter::Client_ServoOut,
+	                               rc::Timer1Arbiter::Resource_TimeBase | rc::Timer1Arbiter::Resource_CompareB) == false)
+	{
+		return false;
+	}
+	
 	// set initial values
 	update(true);
 	
-	// stop timer 1
-	rc::Timer1::stop();
+	// the time base may be shared, so don't stop it; keep the interrupts away instead
+	uint8_t oldSREG = SREG;
+	cli();
 	
 	// disable compare match B interrupts
 	rc::Timer1::setCompareMatch(false, false);
@@ -69,6 +77,9 @@ void ServoOut::start()
 	
 	// start the timer
 	rc::Timer1::start();
+	
+	SREG = oldSREG;
+	return true;
 }
 
 
@@ -129,7 +140,7 @@ void ServoOut::update(bool p_pinsChanged)
 	m_timings[idx] = remainingTime << 1;
 	m_ports[idx] = 0;
 	m_masks[idx] = 0;
-	TIMSK1 = (1 << OCIE1B);
+	TIMSK1 |= (1 << OCIE1B);
 }
 
 
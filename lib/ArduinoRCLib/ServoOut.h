@@ -41,8 +41,9 @@ public:
 	    \param p_maxServos Maximum number of servos supported.*/
 	ServoOut(const uint8_t* p_pins, const uint16_t* p_values, uint8_t* p_work, uint8_t p_maxServos);
 	
-	/*! \brief Starts timers and output.*/
-	void start();
+	/*! \brief Starts timers and output.
+	    \return Whether Timer1 compare unit B could be acquired, see Timer1Arbiter.*/
+	bool start();
 	
 	/*! \brief Sets the minimum length between pulses on a pin.
 	    \param p_length The minimum length between two pulses in microseconds.*/
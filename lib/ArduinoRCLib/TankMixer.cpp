@@ -0,0 +1,170 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** TankMixer.cpp
+** Differential drive (tank) mixing
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <TankMixer.h>
+#include <util.h>
+
+
+namespace rc
+{
+
+/*! \brief Scales a value by a weight.
+    \param p_value Value to scale, range [-256 - 256].
+    \param p_weight Weight, range [0 - 256] where 256 is 100%.
+    \return p_value * p_weight / 256.*/
+static int16_t scale(int16_t p_value, uint16_t p_weight)
+{
+	if (p_weight >= 256)
+	{
+		return p_value;
+	}
+
+	// 256 * 255 still fits in 16 bits, as long as we do this unsigned
+	bool neg = p_value < 0;
+	uint16_t val = static_cast<uint16_t>(neg ? -p_value : p_value);
+	val = (val * p_weight) >> 8;
+	return neg ? -static_cast<int16_t>(val) : static_cast<int16_t>(val);
+}
+
+
+// Public functions
+
+TankMixer::TankMixer(Mode p_mode, uint16_t p_pivotLimit)
+:
+m_mode(p_mode),
+m_throttle(Input_THR),
+m_steering(Input_RUD),
+m_left(Output_TRK1),
+m_right(Output_TRK2)
+{
+	setPivotLimit(p_pivotLimit);
+}
+
+
+void TankMixer::setMode(Mode p_mode)
+{
+	m_mode = p_mode;
+}
+
+
+TankMixer::Mode TankMixer::getMode() const
+{
+	return m_mode;
+}
+
+
+void TankMixer::setPivotLimit(uint16_t p_limit)
+{
+	m_pivotLimit = p_limit > 256 ? 256 : p_limit;
+
+	// precalculate the reciprocal, so we can do without a division while mixing
+	m_pivotGain = m_pivotLimit == 0 ? 0 : 16384 / m_pivotLimit;
+}
+
+
+uint16_t TankMixer::getPivotLimit() const
+{
+	return m_pivotLimit;
+}
+
+
+void TankMixer::setSources(Input p_throttle, Input p_steering)
+{
+	m_throttle = p_throttle;
+	m_steering = p_steering;
+}
+
+
+void TankMixer::setDestinations(Output p_left, Output p_right)
+{
+	m_left  = p_left;
+	m_right = p_right;
+}
+
+
+void TankMixer::apply(int16_t p_throttle,
+                      int16_t p_steering,
+                      int16_t& p_leftOUT,
+                      int16_t& p_rightOUT) const
+{
+	p_throttle = clampNormalized(p_throttle);
+	p_steering = clampNormalized(p_steering);
+
+	switch (m_mode)
+	{
+		case Mode_Arcade:
+		{
+			p_leftOUT  = clampNormalized(p_throttle + p_steering);
+			p_rightOUT = clampNormalized(p_throttle - p_steering);
+		}
+		break;
+
+		case Mode_Tank:
+		{
+			p_leftOUT  = p_throttle;
+			p_rightOUT = p_steering;
+		}
+		break;
+
+		case Mode_PivotBlend:
+		default:
+		{
+			// the outer track runs at throttle, the inner track slows down
+			// until it stops at full steering, both forward and backward
+			uint16_t steering = static_cast<uint16_t>(p_steering < 0 ? -p_steering : p_steering);
+			int16_t inner = scale(p_throttle, 256 - steering);
+
+			p_leftOUT  = p_steering >= 0 ? p_throttle : inner;
+			p_rightOUT = p_steering >= 0 ? inner : p_throttle;
+
+			// near zero throttle, blend into counter rotating tracks
+			uint16_t throttle = static_cast<uint16_t>(p_throttle < 0 ? -p_throttle : p_throttle);
+			if (throttle < m_pivotLimit)
+			{
+				// throttle * m_pivotGain < 16384, so this won't overflow
+				uint16_t pivot = 256 - ((throttle * m_pivotGain) >> 6);
+
+				p_leftOUT  = scale(p_leftOUT,  256 - pivot) + scale(p_steering, pivot);
+				p_rightOUT = scale(p_rightOUT, 256 - pivot) - scale(p_steering, pivot);
+			}
+		}
+		break;
+	}
+}
+
+
+void TankMixer::apply(int16_t p_throttle, int16_t p_steering) const
+{
+	int16_t left;
+	int16_t right;
+	apply(p_throttle, p_steering, left, right);
+
+	if (m_left != Output_None)
+	{
+		setOutput(m_left, left);
+	}
+	if (m_right != Output_None)
+	{
+		setOutput(m_right, right);
+	}
+}
+
+
+void TankMixer::apply() const
+{
+	apply(m_throttle != Input_None ? getInput(m_throttle) : 0,
+	      m_steering != Input_None ? getInput(m_steering) : 0);
+}
+
+
+// namespace end
+}
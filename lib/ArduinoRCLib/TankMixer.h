@@ -0,0 +1,109 @@
+#ifndef INC_RC_TANKMIXER_H
+#define INC_RC_TANKMIXER_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** TankMixer.h
+** Differential drive (tank) mixing
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+#include <input.h>
+#include <output.h>
+
+
+namespace rc
+{
+
+/*!
+ *  \brief     Class to encapsulate differential drive (tank) mixing.
+ *  \details   This class mixes throttle and steering into left and right track outputs.
+ *             All calculations are done in 16 bit integer arithmetic, without divisions.
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ */
+class TankMixer
+{
+public:
+	enum Mode //! Mixing modes
+	{
+		Mode_Arcade,     //!< Single stick, left = throttle + steering, right = throttle - steering
+		Mode_Tank,       //!< Two sticks, throttle input drives the left track, steering input the right track
+		Mode_PivotBlend, //!< Steering slows down the inner track, blends into on the spot turning near zero throttle
+
+		Mode_Count
+	};
+
+	/*! \brief Constructs a TankMixer object
+	    \param p_mode Mixing mode.
+	    \param p_pivotLimit Throttle below which Mode_PivotBlend blends into pivoting, range [0 - 256].*/
+	TankMixer(Mode p_mode = Mode_PivotBlend, uint16_t p_pivotLimit = 64);
+
+	/*! \brief Sets mixing mode.
+	    \param p_mode Mixing mode to set.*/
+	void setMode(Mode p_mode);
+
+	/*! \brief Gets mixing mode.
+	    \return The mixing mode currently set.*/
+	Mode getMode() const;
+
+	/*! \brief Sets the throttle below which Mode_PivotBlend starts pivoting.
+	    \param p_limit The pivot limit, range [0 - 256], 0 disables pivoting.*/
+	void setPivotLimit(uint16_t p_limit);
+
+	/*! \brief Gets the pivot limit.
+	    \return The current pivot limit, range [0 - 256].*/
+	uint16_t getPivotLimit() const;
+
+	/*! \brief Sets the inputs to read from.
+	    \param p_throttle Throttle input (left track in Mode_Tank).
+	    \param p_steering Steering input (right track in Mode_Tank).*/
+	void setSources(Input p_throttle, Input p_steering);
+
+	/*! \brief Sets the outputs to write to.
+	    \param p_left Left track output.
+	    \param p_right Right track output.*/
+	void setDestinations(Output p_left, Output p_right);
+
+	/*! \brief Applies tank mixing.
+	    \param p_throttle The amount of throttle, range [-256 - 256], positive is forward.
+	    \param p_steering The amount of steering, range [-256 - 256], positive is right.
+	    \param p_leftOUT Left track, range [-256 - 256].
+	    \param p_rightOUT Right track, range [-256 - 256].*/
+	void apply(int16_t p_throttle,
+	           int16_t p_steering,
+	           int16_t& p_leftOUT,
+	           int16_t& p_rightOUT) const;
+
+	/*! \brief Applies tank mixing, writes results to the configured outputs.
+	    \param p_throttle The amount of throttle, range [-256 - 256], positive is forward.
+	    \param p_steering The amount of steering, range [-256 - 256], positive is right.*/
+	void apply(int16_t p_throttle, int16_t p_steering) const;
+
+	/*! \brief Applies tank mixing. Fetches input from input system.*/
+	void apply() const;
+
+private:
+	Mode     m_mode;       //!< Mixing mode
+	uint16_t m_pivotLimit; //!< Throttle below which pivoting starts
+	uint16_t m_pivotGain;  //!< 16384 / m_pivotLimit, avoids a division while mixing
+	Input    m_throttle;   //!< Throttle input
+	Input    m_steering;   //!< Steering input
+	Output   m_left;       //!< Left track output
+	Output   m_right;      //!< Right track output
+};
+/** \example tankmixer_example.pde
+ * This is an example of how to use the TankMixer class.
+ */
+
+
+} // namespace end
+
+#endif // INC_RC_TANKMIXER_H
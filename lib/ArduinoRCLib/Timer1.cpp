@@ -18,6 +18,7 @@
 	#include <wiring.h>
 #endif
 
+#include <IsrProfiler.h>
 #include <Timer1.h>
 
 
@@ -48,7 +49,7 @@ void Timer1::init(bool p_debug)
 void Timer1::start()
 {
 	TCCR1B = (TCCR1B & ~(_BV(CS12) | _BV(CS11) | _BV(CS10))) |
-	         s_debug ? (_BV(CS12) | _BV(CS10)) :  _BV(CS11);
+	         (s_debug ? (_BV(CS12) | _BV(CS10)) :  _BV(CS11));
 }
 
 
@@ -128,28 +129,36 @@ void Timer1::setToggle(bool p_enable, bool p_OC1A)
 
 // Interrupt service routines
 
+// latencies assume the 0.5 us time base set by Timer1::start()
+
 ISR(TIMER1_OVF_vect)
 {
+	ISR_PROFILE_BEGIN(TCNT1 >> 1);
 	if (s_TOIE1Callback != 0)
 	{
 		s_TOIE1Callback();
 	}
+	ISR_PROFILE_END(Vector_Timer1Overflow);
 }
 
 
 ISR(TIMER1_COMPA_vect)
 {
+	ISR_PROFILE_BEGIN(static_cast<uint16_t>(TCNT1 - OCR1A) >> 1);
 	if (s_OCI1ACallback != 0)
 	{
 		s_OCI1ACallback();
 	}
+	ISR_PROFILE_END(Vector_Timer1CompareA);
 }
 
 
 ISR(TIMER1_COMPB_vect)
 {
+	ISR_PROFILE_BEGIN(static_cast<uint16_t>(TCNT1 - OCR1B) >> 1);
 	if (s_OCI1BCallback != 0)
 	{
 		s_OCI1BCallback();
 	}
+	ISR_PROFILE_END(Vector_Timer1CompareB);
 }
@@ -0,0 +1,198 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** Timer1Alarm.cpp
+** Software timers on a single Timer1 compare unit
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include <Arduino.h>
+#else
+	#include <avr/interrupt.h>
+	#include <wiring.h>
+#endif
+
+#include <Timer1Alarm.h>
+#include <Timer1Arbiter.h>
+
+
+// minimum distance between now and the compare value, so the match can't be missed
+static const uint16_t s_minLead = 4;
+
+
+namespace rc
+{
+
+Timer1Alarm* Timer1Alarm::s_first = 0;
+uint8_t Timer1Alarm::s_compare = Timer1Arbiter::Resource_None;
+
+
+// Public functions
+
+Timer1Alarm::Timer1Alarm(Timer1::Callback p_callback)
+:
+m_callback(p_callback),
+m_expiry(0),
+m_pending(false),
+m_next(0)
+{
+	
+}
+
+
+bool Timer1Alarm::start(uint16_t p_ticks)
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	bool result = schedule(TCNT1 + p_ticks);
+	SREG = oldSREG;
+	return result;
+}
+
+
+bool Timer1Alarm::restart(uint16_t p_ticks)
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	bool result = schedule(m_expiry + p_ticks);
+	SREG = oldSREG;
+	return result;
+}
+
+
+void Timer1Alarm::stop()
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	if (m_pending)
+	{
+		remove();
+		program();
+	}
+	SREG = oldSREG;
+}
+
+
+bool Timer1Alarm::isPending() const
+{
+	return m_pending;
+}
+
+
+// Private functions
+
+bool Timer1Alarm::schedule(uint16_t p_expiry)
+{
+	// interrupts are disabled here
+	if (s_compare == Timer1Arbiter::Resource_None)
+	{
+		s_compare = Timer1Arbiter::acquireCompare(Timer1Arbiter::Client_Alarm);
+		if (s_compare == Timer1Arbiter::Resource_None)
+		{
+			return false;
+		}
+	}
+	if (Timer1Arbiter::acquire(Timer1Arbiter::Client_Alarm, Timer1Arbiter::Resource_TimeBase) == false)
+	{
+		return false;
+	}
+	if (Timer1::isRunning() == false)
+	{
+		Timer1::start();
+	}
+	
+	if (m_pending)
+	{
+		remove();
+	}
+	m_expiry = p_expiry;
+	m_pending = true;
+	
+	// all pending alarms expire within MaxTicks, so the signed distance
+	// from now sorts them correctly across counter wrap around
+	uint16_t now = TCNT1;
+	int16_t distance = static_cast<int16_t>(m_expiry - now);
+	Timer1Alarm** link = &s_first;
+	while (*link != 0 && static_cast<int16_t>((*link)->m_expiry - now) <= distance)
+	{
+		link = &(*link)->m_next;
+	}
+	m_next = *link;
+	*link = this;
+	
+	if (s_first == this)
+	{
+		program();
+	}
+	return true;
+}
+
+
+void Timer1Alarm::remove()
+{
+	for (Timer1Alarm** link = &s_first; *link != 0; link = &(*link)->m_next)
+	{
+		if (*link == this)
+		{
+			*link = m_next;
+			break;
+		}
+	}
+	m_next = 0;
+	m_pending = false;
+}
+
+
+void Timer1Alarm::program()
+{
+	bool useA = s_compare == Timer1Arbiter::Resource_CompareA;
+	if (s_first == 0)
+	{
+		Timer1::setCompareMatch(false, useA);
+		return;
+	}
+	
+	uint16_t compare = s_first->m_expiry;
+	uint16_t now = TCNT1;
+	if (static_cast<int16_t>(compare - (now + s_minLead)) < 0)
+	{
+		// (almost) due already, fire as soon as possible
+		compare = now + s_minLead;
+	}
+	
+	if (useA)
+	{
+		OCR1A = compare;
+		TIFR1 = _BV(OCF1A);
+	}
+	else
+	{
+		OCR1B = compare;
+		TIFR1 = _BV(OCF1B);
+	}
+	Timer1::setCompareMatch(true, useA, Timer1Alarm::handleInterrupt);
+}
+
+
+void Timer1Alarm::handleInterrupt()
+{
+	// run everything that is due, callbacks may add alarms to the queue
+	while (s_first != 0 && static_cast<int16_t>(s_first->m_expiry - TCNT1) <= 0)
+	{
+		Timer1Alarm* alarm = s_first;
+		alarm->remove();
+		if (alarm->m_callback != 0)
+		{
+			alarm->m_callback();
+		}
+	}
+	program();
+}
+
+// namespace end
+}
@@ -0,0 +1,79 @@
+#ifndef INC_RC_TIMER1ALARM_H
+#define INC_RC_TIMER1ALARM_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** Timer1Alarm.h
+** Software timers on a single Timer1 compare unit
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+#include <Timer1.h>
+
+
+namespace rc
+{
+
+/*!
+ *  \brief     Class to encapsulate a one shot software timer on Timer1.
+ *  \details   All alarms share a single compare unit, handed out by Timer1Arbiter on first use.
+ *             Pending alarms are kept in a queue sorted by expiry time, the compare unit is always
+ *             set to the first one, so the interrupt only fires when an alarm is due.
+ *             Callbacks run in interrupt context and may start alarms, including their own.
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ */
+class Timer1Alarm
+{
+public:
+	static const uint16_t MaxTicks = 0x7FFF; //!< Longest delay, in Timer1 ticks (0.5 us), about 16 ms
+	
+	/*! \brief Constructs a Timer1Alarm object.
+	    \param p_callback Function to call when the alarm expires.*/
+	Timer1Alarm(Timer1::Callback p_callback);
+	
+	/*! \brief Starts the alarm, restarts it if it was pending.
+	    \param p_ticks Delay from now, in Timer1 ticks (0.5 us), range [1 - MaxTicks].
+	    \return Whether a compare unit and the time base were available.*/
+	bool start(uint16_t p_ticks);
+	
+	/*! \brief Starts the alarm relative to its previous expiry, for drift free periodic alarms.
+	    \param p_ticks Delay from the previous expiry, in Timer1 ticks (0.5 us), range [1 - MaxTicks].
+	    \return Whether a compare unit and the time base were available.
+	    \note  Meant to be called from the callback.*/
+	bool restart(uint16_t p_ticks);
+	
+	/*! \brief Stops the alarm if it is pending.*/
+	void stop();
+	
+	/*! \brief Checks if the alarm is pending.
+	    \return Whether the alarm is pending.*/
+	bool isPending() const;
+	
+private:
+	bool schedule(uint16_t p_expiry);
+	void remove();
+	
+	static void program();
+	static void handleInterrupt();
+	
+	Timer1::Callback m_callback; //!< Function to call on expiry
+	uint16_t         m_expiry;   //!< TCNT1 value at which the alarm expires
+	bool             m_pending;  //!< Whether the alarm is in the queue
+	Timer1Alarm*     m_next;     //!< Next alarm in the queue
+	
+	static Timer1Alarm* s_first;   //!< First alarm to expire
+	static uint8_t      s_compare; //!< Compare unit in use (Timer1Arbiter::Resource)
+};
+
+
+} // namespace end
+
+#endif // INC_RC_TIMER1ALARM_H
@@ -0,0 +1,256 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** Timer1Arbiter.cpp
+** Timer1 resource sharing
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include <Arduino.h>
+#else
+	#include <avr/interrupt.h>
+	#include <wiring.h>
+#endif
+
+#include <Timer1Arbiter.h>
+
+
+// Static variables, owners of CompareA, CompareB, Capture and Waveform
+static const uint8_t s_ownedCount = 4;
+static rc::Timer1Arbiter::Client s_owners[s_ownedCount] = { rc::Timer1Arbiter::Client_None };
+static uint8_t s_timeBaseUsers = 0;
+static uint8_t s_conflicts = 0;
+static uint8_t s_conflictResources = 0;
+static volatile rc::Timer1::Callback s_overflowCallbacks[rc::Timer1Arbiter::MaxOverflowCallbacks] = { 0 };
+
+
+namespace rc
+{
+
+/*! \brief Converts a single owned resource to its index in s_owners.
+    \param p_resource Resource_CompareA, Resource_CompareB, Resource_Capture or Resource_Waveform.
+    \return Index in s_owners.*/
+static uint8_t ownerIndex(uint8_t p_resource)
+{
+	switch (p_resource)
+	{
+	case Timer1Arbiter::Resource_CompareA: return 0;
+	case Timer1Arbiter::Resource_CompareB: return 1;
+	case Timer1Arbiter::Resource_Capture:  return 2;
+	default:                               return 3;
+	}
+}
+
+
+// Public functions
+
+bool Timer1Arbiter::acquire(Client p_client, uint8_t p_resources)
+{
+	uint8_t refused = 0;
+	
+	uint8_t oldSREG = SREG;
+	cli();
+	
+	// the counter can't be a time base while someone else runs it as PWM, and vice versa
+	if ((p_resources & Resource_TimeBase) != 0 &&
+	    s_owners[ownerIndex(Resource_Waveform)] != Client_None &&
+	    s_owners[ownerIndex(Resource_Waveform)] != p_client)
+	{
+		refused |= Resource_TimeBase;
+	}
+	if ((p_resources & Resource_Waveform) != 0 && (s_timeBaseUsers & ~p_client) != 0)
+	{
+		refused |= Resource_Waveform;
+	}
+	
+	for (uint8_t resource = Resource_CompareA; resource <= Resource_Waveform; resource <<= 1)
+	{
+		if ((p_resources & resource) != 0)
+		{
+			Client owner = s_owners[ownerIndex(resource)];
+			if (owner != Client_None && owner != p_client)
+			{
+				refused |= resource;
+			}
+		}
+	}
+	
+	if (refused != 0)
+	{
+		s_conflicts |= p_client;
+		s_conflictResources |= refused;
+	}
+	else
+	{
+		if ((p_resources & Resource_TimeBase) != 0)
+		{
+			s_timeBaseUsers |= p_client;
+		}
+		for (uint8_t resource = Resource_CompareA; resource <= Resource_Waveform; resource <<= 1)
+		{
+			if ((p_resources & resource) != 0)
+			{
+				s_owners[ownerIndex(resource)] = p_client;
+			}
+		}
+	}
+	
+	SREG = oldSREG;
+	
+	return refused == 0;
+}
+
+
+Timer1Arbiter::Resource Timer1Arbiter::acquireCompare(Client p_client)
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	
+	Client ownerA = s_owners[ownerIndex(Resource_CompareA)];
+	Client ownerB = s_owners[ownerIndex(Resource_CompareB)];
+	
+	// prefer B, PPMOut can only use A
+	Resource result = Resource_None;
+	if (ownerA == p_client || (ownerB != Client_None && ownerB != p_client && ownerA == Client_None))
+	{
+		result = Resource_CompareA;
+	}
+	else
+	{
+		result = Resource_CompareB;
+	}
+	
+	// records the conflict if both are taken
+	if (acquire(p_client, result) == false)
+	{
+		result = Resource_None;
+	}
+	
+	SREG = oldSREG;
+	
+	return result;
+}
+
+
+void Timer1Arbiter::release(Client p_client)
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	
+	s_timeBaseUsers &= ~p_client;
+	for (uint8_t i = 0; i < s_ownedCount; ++i)
+	{
+		if (s_owners[i] == p_client)
+		{
+			s_owners[i] = Client_None;
+		}
+	}
+	
+	SREG = oldSREG;
+}
+
+
+Timer1Arbiter::Client Timer1Arbiter::getOwner(Resource p_resource)
+{
+	return p_resource == Resource_None || p_resource == Resource_TimeBase ?
+	       Client_None : s_owners[ownerIndex(p_resource)];
+}
+
+
+uint8_t Timer1Arbiter::getTimeBaseUsers()
+{
+	return s_timeBaseUsers;
+}
+
+
+bool Timer1Arbiter::addOverflowCallback(Timer1::Callback p_callback)
+{
+	// the pointer takes two writes, handleOverflow may run in between once TOIE1 is on
+	uint8_t oldSREG = SREG;
+	cli();
+	
+	bool added = false;
+	for (uint8_t i = 0; i < MaxOverflowCallbacks && added == false; ++i)
+	{
+		added = s_overflowCallbacks[i] == p_callback;
+	}
+	
+	for (uint8_t i = 0; i < MaxOverflowCallbacks && added == false; ++i)
+	{
+		if (s_overflowCallbacks[i] == 0)
+		{
+			s_overflowCallbacks[i] = p_callback;
+			Timer1::setOverflow(true, Timer1Arbiter::handleOverflow);
+			added = true;
+		}
+	}
+	
+	SREG = oldSREG;
+	return added;
+}
+
+
+void Timer1Arbiter::removeOverflowCallback(Timer1::Callback p_callback)
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	
+	bool any = false;
+	for (uint8_t i = 0; i < MaxOverflowCallbacks; ++i)
+	{
+		if (s_overflowCallbacks[i] == p_callback)
+		{
+			s_overflowCallbacks[i] = 0;
+		}
+		any = any || s_overflowCallbacks[i] != 0;
+	}
+	
+	if (any == false)
+	{
+		Timer1::setOverflow(false);
+	}
+	
+	SREG = oldSREG;
+}
+
+
+uint8_t Timer1Arbiter::getConflicts()
+{
+	return s_conflicts;
+}
+
+
+uint8_t Timer1Arbiter::getConflictResources()
+{
+	return s_conflictResources;
+}
+
+
+void Timer1Arbiter::clearConflicts()
+{
+	s_conflicts = 0;
+	s_conflictResources = 0;
+}
+
+
+// Private functions
+
+void Timer1Arbiter::handleOverflow()
+{
+	for (uint8_t i = 0; i < MaxOverflowCallbacks; ++i)
+	{
+		Timer1::Callback callback = s_overflowCallbacks[i];
+		if (callback != 0)
+		{
+			callback();
+		}
+	}
+}
+
+// namespace end
+}
@@ -0,0 +1,120 @@
+#ifndef INC_RC_TIMER1ARBITER_H
+#define INC_RC_TIMER1ARBITER_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** Timer1Arbiter.h
+** Timer1 resource sharing
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+#include <Timer1.h>
+
+
+namespace rc
+{
+
+/*!
+ *  \brief     Class to share Timer1 between its users.
+ *  \details   Timer1 is used as a free running 0.5 us time base by ServoIn, PPMIn and pulse capture,
+ *             its compare units are used by ServoOut, PPMOut and Timer1Alarm, and motor drivers
+ *             reconfigure it for PWM. Each user acquires the resources it needs before touching the timer.
+ *             The time base may be shared, all other resources have a single owner. A request that
+ *             cannot be granted is refused and recorded, so conflicts can be reported later on.
+ *             Several overflow callbacks may be subscribed at the same time.
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ */
+class Timer1Arbiter
+{
+public:
+	enum Client //! Timer1 users, bit flags
+	{
+		Client_None     = 0x00,
+		Client_ServoIn  = 0x01, //!< ServoIn, pulse measurement
+		Client_PPMIn    = 0x02, //!< PPMIn, pulse measurement
+		Client_ServoOut = 0x04, //!< ServoOut, compare unit B
+		Client_PPMOut   = 0x08, //!< PPMOut, compare unit A
+		Client_Alarm    = 0x10, //!< Timer1Alarm, any free compare unit
+		Client_Motor    = 0x20, //!< Motor PWM on OC1A/OC1B
+		Client_Capture  = 0x40, //!< Input capture unit (ICP1)
+		Client_User     = 0x80  //!< Sketch code
+	};
+	
+	enum Resource //! Timer1 resources, bit flags
+	{
+		Resource_None     = 0x00,
+		Resource_TimeBase = 0x01, //!< Free running counter at 0.5 us per tick, shared
+		Resource_CompareA = 0x02, //!< Output compare unit A
+		Resource_CompareB = 0x04, //!< Output compare unit B
+		Resource_Capture  = 0x08, //!< Input capture unit
+		Resource_Waveform = 0x10  //!< Mode and prescaler (PWM), excludes Resource_TimeBase
+	};
+	
+	static const uint8_t MaxOverflowCallbacks = 4; //!< Maximum number of overflow subscribers
+	
+	/*! \brief Acquires Timer1 resources.
+	    \param p_client The client requesting the resources.
+	    \param p_resources Resources to acquire, Resource flags or'ed together.
+	    \return Whether all resources were granted, nothing is acquired otherwise.
+	    \note  Resources already owned by p_client are granted again.*/
+	static bool acquire(Client p_client, uint8_t p_resources);
+	
+	/*! \brief Acquires whichever compare unit is free.
+	    \param p_client The client requesting the compare unit.
+	    \return Resource_CompareA, Resource_CompareB or Resource_None if both are taken.*/
+	static Resource acquireCompare(Client p_client);
+	
+	/*! \brief Releases all resources held by a client.
+	    \param p_client The client to release the resources of.*/
+	static void release(Client p_client);
+	
+	/*! \brief Gets the owner of a resource.
+	    \param p_resource The resource to look up, Resource_TimeBase has no single owner.
+	    \return The client owning the resource or Client_None.*/
+	static Client getOwner(Resource p_resource);
+	
+	/*! \brief Gets the clients sharing the time base.
+	    \return Client flags of all time base users.*/
+	static uint8_t getTimeBaseUsers();
+	
+	/*! \brief Subscribes to the Timer1 overflow interrupt.
+	    \param p_callback Function to call at interrupt.
+	    \return Whether there was room for the callback.*/
+	static bool addOverflowCallback(Timer1::Callback p_callback);
+	
+	/*! \brief Unsubscribes from the Timer1 overflow interrupt.
+	    \param p_callback Function to remove.*/
+	static void removeOverflowCallback(Timer1::Callback p_callback);
+	
+	/*! \brief Gets the clients that were refused resources.
+	    \return Client flags of all refused clients since the last clearConflicts().*/
+	static uint8_t getConflicts();
+	
+	/*! \brief Gets the resources that were refused.
+	    \return Resource flags of all refused resources since the last clearConflicts().*/
+	static uint8_t getConflictResources();
+	
+	/*! \brief Forgets all recorded conflicts.*/
+	static void clearConflicts();
+	
+private:
+	Timer1Arbiter(); //!< Not instantiable
+	
+	static void handleOverflow();
+};
+/** \example timer1arbiter_example.pde
+ * This is an example of how to use the Timer1Arbiter and Timer1Alarm classes.
+ */
+
+
+} // namespace end
+
+#endif // INC_RC_TIMER1ARBITER_H
@@ -0,0 +1,169 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** TransferFunction.cpp
+** Dual rates, expo and curve of a single input fused into one table
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <DualRates.h>
+#include <Expo.h>
+#include <TransferFunction.h>
+#include <util.h>
+
+
+namespace rc
+{
+
+// Public functions
+
+TransferFunction::TransferFunction(int16_t* p_table, uint8_t p_shift, Input p_index)
+:
+InputModifier(p_index),
+m_table(p_table),
+m_shift(p_shift),
+m_valid(false),
+m_rates(0),
+m_expo(0),
+m_curve(0),
+m_rate(0),
+m_expoValue(0)
+{
+	
+}
+
+
+void TransferFunction::setDualRates(const DualRates& p_rates)
+{
+	m_rates = addressOf(p_rates);
+	m_valid = false;
+}
+
+
+void TransferFunction::setExpo(const Expo& p_expo)
+{
+	m_expo  = addressOf(p_expo);
+	m_valid = false;
+}
+
+
+void TransferFunction::setCurve(const Curve& p_curve)
+{
+	m_curve = addressOf(p_curve);
+	m_valid = false;
+}
+
+
+void TransferFunction::clear()
+{
+	m_rates = 0;
+	m_expo  = 0;
+	m_curve = 0;
+	m_valid = false;
+}
+
+
+bool TransferFunction::update()
+{
+	// the parameters may have been changed through a pointer, so compare them all
+	bool changed = m_valid == false;
+	if (m_rates != 0 && m_rates->get() != m_rate)
+	{
+		m_rate  = m_rates->get();
+		changed = true;
+	}
+	if (m_expo != 0 && m_expo->get() != m_expoValue)
+	{
+		m_expoValue = m_expo->get();
+		changed     = true;
+	}
+	if (m_curve != 0)
+	{
+		for (uint8_t i = 0; i < Curve::PointCount; ++i)
+		{
+			if (m_curve->getPoint(i) != m_points[i])
+			{
+				m_points[i] = m_curve->getPoint(i);
+				changed     = true;
+			}
+		}
+	}
+	
+	if (changed == false)
+	{
+		return false;
+	}
+	
+	uint16_t size = TRANSFERFUNCTION_TABLE_SIZE(m_shift);
+	for (uint16_t i = 0; i < size; ++i)
+	{
+		m_table[i] = calculate(static_cast<int16_t>(i << m_shift) - 256);
+	}
+	m_valid = true;
+	return true;
+}
+
+
+int16_t TransferFunction::apply(int16_t p_value) const
+{
+	if (m_valid == false || p_value < -256 || p_value > 256)
+	{
+		return calculate(p_value);
+	}
+	
+	uint16_t x = static_cast<uint16_t>(p_value + 256); // range [0 - 512]
+	if (m_shift == 0)
+	{
+		return m_table[x];
+	}
+	
+	uint16_t index = x >> m_shift;
+	uint16_t rem   = x & ((1 << m_shift) - 1);
+	if (rem == 0)
+	{
+		return m_table[index];
+	}
+	
+	// the difference may exceed 512 with dual rates over 100%, do this in 32 bits
+	int16_t low  = m_table[index];
+	int16_t high = m_table[index + 1];
+	return low + static_cast<int16_t>((static_cast<int32_t>(high - low) * rem) >> m_shift);
+}
+
+
+void TransferFunction::apply()
+{
+	if (m_index != Input_None)
+	{
+		update();
+		rc::setInput(m_index, apply(rc::getInput(m_index)));
+	}
+}
+
+
+// Private functions
+
+int16_t TransferFunction::calculate(int16_t p_value) const
+{
+	if (m_rates != 0)
+	{
+		p_value = m_rates->apply(p_value);
+	}
+	if (m_expo != 0)
+	{
+		p_value = m_expo->apply(p_value);
+	}
+	if (m_curve != 0)
+	{
+		p_value = m_curve->interpolate(p_value);
+	}
+	return p_value;
+}
+
+
+// namespace end
+}
@@ -0,0 +1,109 @@
+#ifndef INC_RC_TRANSFERFUNCTION_H
+#define INC_RC_TRANSFERFUNCTION_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** TransferFunction.h
+** Dual rates, expo and curve of a single input fused into one table
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+#include <Curve.h>
+#include <InputModifier.h>
+
+#define TRANSFERFUNCTION_TABLE_SIZE(shift) ((512 >> (shift)) + 1)
+
+
+namespace rc
+{
+
+class DualRates;
+class Expo;
+
+/*!
+ *  \brief     Class to apply DualRates, Expo and Curve to an input with a single table lookup.
+ *  \details   The result of the whole chain, dual rates then expo then curve, is calculated for every
+ *             input value and stored in a table supplied by the user. With a shift of 0 the table has
+ *             an entry for every value in [-256 - 256], 513 entries, and gives exactly the same
+ *             results as applying the stages one by one. On a tight RAM budget use a larger shift,
+ *             values between table entries are then interpolated linearly. With the linear curve and
+ *             dual rates up to 100% the error stays within 4 steps with a shift of 1 (257 entries)
+ *             and within 11 steps with a shift of 3 (65 entries), up to 140% within 6 and 15 steps.
+ *             Steeper curves scale the error with their slope, a curve segment twice as steep as
+ *             the linear curve about doubles it.
+ *             The stages are referenced, not copied, and their own input indices are not used.
+ *             update() compares the stage parameters with those the table was calculated for and
+ *             only recalculates the table when they changed, which takes some 10 ms for 513 entries.
+ *             Values outside [-256 - 256] are calculated stage by stage.
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ */
+class TransferFunction : public InputModifier
+{
+public:
+	/*! \brief Constructs a TransferFunction object.
+	    \param p_table Table buffer, should be TRANSFERFUNCTION_TABLE_SIZE(p_shift) elements large.
+	    \param p_shift Distance between table entries as a power of two, range [0 - 6], 0 is exact.
+	    \param p_index Input index to use for input and output.*/
+	TransferFunction(int16_t* p_table, uint8_t p_shift, Input p_index = Input_None);
+	
+	/*! \brief Sets the dual rates stage.
+	    \param p_rates The DualRates object, must outlive this object.*/
+	void setDualRates(const DualRates& p_rates);
+	
+	/*! \brief Sets the expo stage.
+	    \param p_expo The Expo object, must outlive this object.*/
+	void setExpo(const Expo& p_expo);
+	
+	/*! \brief Sets the curve stage.
+	    \param p_curve The Curve object, must outlive this object.*/
+	void setCurve(const Curve& p_curve);
+	
+	/*! \brief Removes all stages.*/
+	void clear();
+	
+	/*! \brief Recalculates the table if a stage or a stage parameter changed.
+	    \return Whether the table was recalculated.*/
+	bool update();
+	
+	/*! \brief Applies the stages using the table, call update() after changing a parameter.
+	    \param p_value Source value, range [-256 - 256].
+	    \return dual rates, expo and curve applied to p_value.*/
+	int16_t apply(int16_t p_value) const;
+	
+	/*! \brief Updates the table if needed and applies the stages to the configured input.*/
+	void apply();
+
+private:
+	/*! \brief Applies the stages one by one.
+	    \param p_value Source value.
+	    \return dual rates, expo and curve applied to p_value.*/
+	int16_t calculate(int16_t p_value) const;
+	
+	int16_t*         m_table;  //!< Table, external buffer
+	uint8_t          m_shift;  //!< Distance between table entries as a power of two
+	bool             m_valid;  //!< Whether the table matches the stages
+	const DualRates* m_rates;  //!< Dual rates stage, may be 0
+	const Expo*      m_expo;   //!< Expo stage, may be 0
+	const Curve*     m_curve;  //!< Curve stage, may be 0
+	
+	// the stage parameters the table was calculated for
+	uint8_t m_rate;                      //!< Dual rate
+	int8_t  m_expoValue;                 //!< Expo
+	int16_t m_points[Curve::PointCount]; //!< Curve points
+};
+/** \example transferfunction_example.pde
+ * This is an example of how to use the TransferFunction class.
+ */
+
+
+} // namespace end
+
+#endif // INC_RC_TRANSFERFUNCTION_H
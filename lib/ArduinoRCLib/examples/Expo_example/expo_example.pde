@@ -16,6 +16,9 @@
 
 rc::Expo g_expo;
 
+// keeps the compiler from optimizing the timed expo away
+volatile int16_t g_result;
+
 void setup()
 {
 	// we use 30% expo, dumb down the sensitivity in the center a bit, if we
@@ -26,6 +29,31 @@ void setup()
 	// g_expo.setIndex(rc::Input_AIL);
 	// or specify it as a constructor parameter
 	// Then input will be read from (and results will be written back to) the input system
+	
+	// apply() interpolates and divides by 100, a lookup table makes it a lot faster
+	// at the cost of 259 bytes of RAM, shared by all Expo objects with the same expo.
+	// The table is regenerated when the expo is changed with set() or =
+	// Tables are opt-in, build with -DEXPOTABLE_CACHE_SIZE=1 (or more) to use them.
+	Serial.begin(115200);
+	for (uint8_t useTable = 0; useTable < 2; ++useTable)
+	{
+		if (g_expo.setUseTable(useTable != 0) != (useTable != 0))
+		{
+			Serial.println("no table, EXPOTABLE_CACHE_SIZE is 0");
+			break;
+		}
+		
+		uint32_t start = micros();
+		for (int16_t value = -256; value < 256; ++value)
+		{
+			g_result = g_expo.apply(value);
+		}
+		uint32_t duration = micros() - start;
+		
+		Serial.print(useTable != 0 ? "table: " : "interpolation: ");
+		Serial.print((duration * clockCyclesPerMicrosecond()) / 512);
+		Serial.println(" cycles per apply");
+	}
 }
 
 void loop()
@@ -0,0 +1,49 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** isrprofiler_example.pde
+** Demonstrate IsrProfiler functionality
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+// ISR_PROFILER has to be defined for all files of the build, defining it here
+// is not enough. In the Arduino IDE add it to the compiler flags, with
+// PlatformIO use build_flags = -DISR_PROFILER
+#include <IsrProfiler.h>
+#include <ServoOut.h>
+#include <Timer1.h>
+
+#ifndef ISR_PROFILER
+#error "build with -DISR_PROFILER"
+#endif
+
+// two servos on pins 2 and 3, each pulse costs a Timer1 compare interrupt
+uint8_t  g_pins[2]   = {2, 3};
+uint16_t g_values[2] = {1500, 1500};
+uint8_t  g_work[SERVOOUT_WORK_SIZE(2)];
+rc::ServoOut g_ServoOut(g_pins, g_values, g_work, 2);
+
+
+void setup()
+{
+	Serial.begin(9600);
+	
+	// call the init function before any other Timer1 function.
+	rc::Timer1::init();
+	
+	rc::IsrProfiler::reset();
+	g_ServoOut.start();
+}
+
+
+void loop()
+{
+	// every second, print how long the compare interrupt took and how late it started
+	delay(1000);
+	rc::IsrProfiler::print(Serial);
+	rc::IsrProfiler::reset();
+}
@@ -0,0 +1,130 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** pipeline_example.pde
+** Demonstrate Pipeline functionality
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <AIPin.h>
+#include <Curve.h>
+#include <DIPin.h>
+#include <DualRates.h>
+#include <Expo.h>
+#include <InputToInputMix.h>
+#include <Pipeline.h>
+#include <ThrottleHold.h>
+
+
+rc::AIPin g_aPins[3] =
+{
+	rc::AIPin(A0, rc::Input_AIL),
+	rc::AIPin(A1, rc::Input_ELE),
+	rc::AIPin(A2, rc::Input_THR)
+};
+rc::DIPin g_holdSwitch(3);
+
+rc::DualRates g_ailDR(80, rc::Input_AIL);
+rc::Expo      g_ailExpo(-30, rc::Input_AIL);
+rc::Expo      g_eleExpo(-20, rc::Input_ELE);
+
+rc::InputToInputMix g_ailToThr(5, true, rc::Input_AIL, rc::Input_THR);
+rc::Curve           g_thrCurve(rc::Curve::DefaultCurve_Linear, rc::Input_THR, rc::Input_THR);
+rc::Curve           g_pitCurve(rc::Curve::DefaultCurve_HalfLinear, rc::Input_THR, rc::Input_PIT);
+rc::ThrottleHold    g_throttleHold;
+bool                g_hold = false;
+
+rc::Pipeline g_pipeline;
+
+void setup()
+{
+	Serial.begin(115200);
+	
+	// The order in which stages are added only matters for stages writing the same input,
+	// here expo is applied before dual rates on aileron, and the throttle curve before throttle hold.
+	// The pitch curve reads throttle, so it runs after all stages writing throttle, even though
+	// it was added first. The aileron to throttle mix reads aileron, so it runs after expo and
+	// dual rates.
+	g_pipeline.add(g_pitCurve);
+	g_pipeline.add(g_ailToThr);
+	g_pipeline.add(g_thrCurve);
+	g_pipeline.add(g_throttleHold, g_hold);
+	g_pipeline.add(g_ailExpo);
+	g_pipeline.add(g_ailDR);
+	g_pipeline.add(g_eleExpo);
+	
+	if (g_pipeline.compile() == false)
+	{
+		Serial.println("stages depend on each other in a loop");
+	}
+	
+	// measure how long a run takes, compared to calling apply() on every object
+	// invalidate() makes run() evaluate all stages, as if all inputs changed
+	uint32_t start = micros();
+	for (uint8_t i = 0; i < 100; ++i)
+	{
+		g_pipeline.invalidate();
+		g_pipeline.run();
+	}
+	uint32_t pipelineDuration = micros() - start;
+	
+	// without any input changing all stages but throttle hold are skipped
+	start = micros();
+	for (uint8_t i = 0; i < 100; ++i)
+	{
+		g_pipeline.run();
+	}
+	uint32_t idleDuration = micros() - start;
+	
+	start = micros();
+	for (uint8_t i = 0; i < 100; ++i)
+	{
+		g_ailExpo.apply();
+		g_ailDR.apply();
+		g_eleExpo.apply();
+		g_ailToThr.apply();
+		g_thrCurve.apply();
+		g_throttleHold.apply(g_hold);
+		g_pitCurve.apply();
+	}
+	uint32_t applyDuration = micros() - start;
+	
+	Serial.print("pipeline: ");
+	Serial.print((pipelineDuration * clockCyclesPerMicrosecond()) / 100);
+	Serial.print(" cycles per run, nothing changed: ");
+	Serial.print((idleDuration * clockCyclesPerMicrosecond()) / 100);
+	Serial.print(" cycles, apply(): ");
+	Serial.print((applyDuration * clockCyclesPerMicrosecond()) / 100);
+	Serial.println(" cycles");
+}
+
+void loop()
+{
+	// read the sticks and switch
+	g_aPins[0].read();
+	g_aPins[1].read();
+	g_aPins[2].read();
+	g_hold = g_holdSwitch.read();
+	
+	// one call applies expo, dual rates, mixes and curves, in the right order
+	// only the stages depending on an input that changed are evaluated
+	g_pipeline.run();
+	
+	// the results can be found in the input system, ie: rc::getInput(rc::Input_PIT)
+	
+	// after changing a parameter, ie: g_ailDR = 100, call g_pipeline.invalidate()
+	
+	static uint8_t frames = 0;
+	if (++frames == 50)
+	{
+		frames = 0;
+		Serial.print("evaluated ");
+		Serial.print(g_pipeline.getEvaluatedCount());
+		Serial.print(", skipped ");
+		Serial.println(g_pipeline.getSkippedCount());
+	}
+}
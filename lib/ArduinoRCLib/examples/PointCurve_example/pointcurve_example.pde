@@ -0,0 +1,65 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** pointcurve_example.pde
+** Demonstrate PointCurve functionality
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <AIPin.h>
+#include <PointCurve.h>
+
+
+// a throttle curve for a tracked vehicle: 5 points, sampled every 8 steps
+typedef rc::PointCurve<5, 65> ThrottleCurve;
+
+rc::AIPin     g_throttle(A0, rc::Input_THR);
+ThrottleCurve g_curve(rc::Curve::DefaultCurve_Linear, rc::Input_THR, rc::Input_THR);
+
+void setup()
+{
+	Serial.begin(115200);
+	
+	// fine control around standstill, full power only near the stick ends
+	g_curve.setPoint(0, -256);
+	g_curve.setPoint(1,  -80);
+	g_curve.setPoint(2,    0);
+	g_curve.setPoint(3,   80);
+	g_curve.setPoint(4,  256);
+	
+	// round off the corners, the curve still passes through the points
+	// and never runs backwards between them
+	g_curve.setInterpolation(ThrottleCurve::Interpolation_Smooth);
+	
+	for (int16_t value = -256; value <= 256; value += 32)
+	{
+		Serial.print(value);
+		Serial.print(" -> ");
+		Serial.println(g_curve.apply(value));
+	}
+	
+	// the curve is precalculated by setPoint() and setInterpolation(),
+	// apply() costs the same for linear and smooth curves
+	uint32_t start = micros();
+	for (int16_t value = -256; value < 256; ++value)
+	{
+		g_curve.apply(value);
+	}
+	uint32_t duration = micros() - start;
+	
+	Serial.print((duration * clockCyclesPerMicrosecond()) / 512);
+	Serial.println(" cycles per apply");
+}
+
+void loop()
+{
+	// read the stick, result ends up in Input_THR
+	g_throttle.read();
+	
+	// apply the curve, reads from and writes to Input_THR
+	g_curve.apply();
+}
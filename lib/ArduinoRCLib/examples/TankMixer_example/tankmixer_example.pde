@@ -0,0 +1,94 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** tankmixer_example.pde
+** Demonstrate TankMixer functionality
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <AIPin.h>
+#include <TankMixer.h>
+#include <output.h>
+
+
+rc::AIPin g_throttle(A0, rc::Input_THR);
+rc::AIPin g_steering(A1, rc::Input_RUD);
+
+rc::TankMixer g_mixer;
+
+// keeps the compiler from optimizing the timed mixing away
+volatile int16_t g_left;
+volatile int16_t g_right;
+
+void setup()
+{
+	Serial.begin(115200);
+	
+	// Mode_PivotBlend is the default, the inner track slows down when steering
+	// and below 25% throttle (64) the tank starts turning on the spot.
+	// Mode_Arcade adds/subtracts steering to/from throttle,
+	// Mode_Tank simply passes the two inputs to the two tracks.
+	g_mixer.setMode(rc::TankMixer::Mode_PivotBlend);
+	g_mixer.setPivotLimit(64);
+	
+	// measure how long a mix takes in each mode, the loop overhead is included
+	for (uint8_t mode = 0; mode < rc::TankMixer::Mode_Count; ++mode)
+	{
+		g_mixer.setMode(static_cast<rc::TankMixer::Mode>(mode));
+		
+		int16_t left;
+		int16_t right;
+		uint32_t start = micros();
+		for (int16_t throttle = -256; throttle < 256; throttle += 2)
+		{
+			g_mixer.apply(throttle, throttle >> 1, left, right);
+			g_left  = left;
+			g_right = right;
+		}
+		uint32_t duration = micros() - start;
+		
+		Serial.print("mode ");
+		Serial.print(mode);
+		Serial.print(": ");
+		Serial.print((duration * clockCyclesPerMicrosecond()) / 256);
+		Serial.println(" cycles per mix");
+	}
+	
+	// and the same with map(), which needs a 32 bit division for every call
+	uint32_t start = micros();
+	for (int16_t throttle = -256; throttle < 256; throttle += 2)
+	{
+		int16_t speed    = map(abs(throttle), 0, 256, 0, 255);
+		int16_t slowdown = map(abs(throttle >> 1), 0, 256, 0, 255);
+		g_left  = throttle < 0 ? -speed : speed;
+		g_right = throttle < 0 ? -speed : speed - slowdown;
+	}
+	uint32_t duration = micros() - start;
+	
+	Serial.print("map(): ");
+	Serial.print((duration * clockCyclesPerMicrosecond()) / 256);
+	Serial.println(" cycles per mix");
+	
+	g_mixer.setMode(rc::TankMixer::Mode_PivotBlend);
+}
+
+void loop()
+{
+	// read the sticks, results end up in Input_THR and Input_RUD
+	g_throttle.read();
+	g_steering.read();
+	
+	// mix, results end up in Output_TRK1 and Output_TRK2
+	g_mixer.apply();
+	
+	// we can then use the track values to drive a motor driver,
+	// range [-256 - 256], negative values mean backwards
+	int16_t left  = rc::getOutput(rc::Output_TRK1);
+	int16_t right = rc::getOutput(rc::Output_TRK2);
+	(void)left;
+	(void)right;
+}
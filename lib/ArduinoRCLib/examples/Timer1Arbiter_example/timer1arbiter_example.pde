@@ -0,0 +1,80 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** timer1arbiter_example.pde
+** Demonstrate Timer1Arbiter and Timer1Alarm functionality
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <ServoOut.h>
+#include <Timer1.h>
+#include <Timer1Alarm.h>
+#include <Timer1Arbiter.h>
+
+// forward declaration of callback functions
+void blinkA();
+void blinkB();
+
+// two software timers, sharing a single compare unit
+rc::Timer1Alarm g_alarmA(blinkA);
+rc::Timer1Alarm g_alarmB(blinkB);
+
+// one servo on pin 2
+uint8_t  g_pins[1]   = {2};
+uint16_t g_values[1] = {1500};
+uint8_t  g_work[SERVOOUT_WORK_SIZE(1)];
+rc::ServoOut g_ServoOut(g_pins, g_values, g_work, 1);
+
+
+void setup()
+{
+	Serial.begin(9600);
+	
+	// call the init function before any other Timer1 function.
+	rc::Timer1::init();
+	
+	pinMode(12, OUTPUT);
+	pinMode(13, OUTPUT);
+	
+	// ServoOut takes compare unit B and shares the time base
+	g_ServoOut.start();
+	
+	// the alarms get compare unit A, the only one left
+	g_alarmA.start(10000); // 5 ms
+	g_alarmB.start(15000); // 7.5 ms
+	
+	// PWM would need the whole timer, this is refused and recorded
+	if (rc::Timer1Arbiter::acquire(rc::Timer1Arbiter::Client_Motor, rc::Timer1Arbiter::Resource_Waveform) == false)
+	{
+		Serial.print("refused clients: ");
+		Serial.print(rc::Timer1Arbiter::getConflicts(), HEX);
+		Serial.print(", resources: ");
+		Serial.println(rc::Timer1Arbiter::getConflictResources(), HEX);
+	}
+}
+
+
+void loop()
+{
+	// nothing to do here, everything is done in interrupts
+}
+
+
+void blinkA()
+{
+	// toggle pin 12 every 5 ms, relative to the previous expiry so it doesn't drift
+	digitalWrite(12, !digitalRead(12));
+	g_alarmA.restart(10000);
+}
+
+
+void blinkB()
+{
+	// toggle pin 13 every 7.5 ms
+	digitalWrite(13, !digitalRead(13));
+	g_alarmB.restart(15000);
+}
@@ -0,0 +1,86 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** transferfunction_example.pde
+** Demonstrate TransferFunction functionality
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <AIPin.h>
+#include <Curve.h>
+#include <DIPin.h>
+#include <DualRates.h>
+#include <Expo.h>
+#include <TransferFunction.h>
+
+
+rc::AIPin g_throttle(A0, rc::Input_THR);
+rc::DIPin g_rateSwitch(3);
+
+// the stages, their input indices are not used by TransferFunction
+rc::DualRates g_rates(100);
+rc::Expo      g_expo(-20);
+rc::Curve     g_curve(rc::Curve::DefaultCurve_Linear);
+
+// a shift of 0 gives exact results, but takes 1026 bytes of RAM
+// a shift of 2 takes 258 bytes, values between entries are interpolated
+int16_t              g_table[TRANSFERFUNCTION_TABLE_SIZE(2)];
+rc::TransferFunction g_transfer(g_table, 2, rc::Input_THR);
+
+void setup()
+{
+	Serial.begin(115200);
+	
+	// soft start for a tracked vehicle
+	g_curve[1] = -160;
+	g_curve[7] =  160;
+	
+	// dual rates, then expo, then the curve
+	g_transfer.setDualRates(g_rates);
+	g_transfer.setExpo(g_expo);
+	g_transfer.setCurve(g_curve);
+	
+	// measure how long calculating the table takes
+	uint32_t start = micros();
+	g_transfer.update();
+	Serial.print("update: ");
+	Serial.print(micros() - start);
+	Serial.println(" us");
+	
+	// and a lookup, compared to applying the stages one by one
+	start = micros();
+	for (int16_t value = -256; value < 256; ++value)
+	{
+		g_transfer.apply(value);
+	}
+	uint32_t fused = micros() - start;
+	
+	start = micros();
+	for (int16_t value = -256; value < 256; ++value)
+	{
+		g_curve.apply(g_expo.apply(g_rates.apply(value)));
+	}
+	uint32_t stages = micros() - start;
+	
+	Serial.print("table: ");
+	Serial.print((fused * clockCyclesPerMicrosecond()) / 512);
+	Serial.print(" cycles per apply, stages: ");
+	Serial.print((stages * clockCyclesPerMicrosecond()) / 512);
+	Serial.println(" cycles");
+}
+
+void loop()
+{
+	// low rate while the switch is on
+	g_rates = g_rateSwitch.read() ? 50 : 100;
+	
+	// read the stick, result ends up in Input_THR
+	g_throttle.read();
+	
+	// recalculates the table after the rate changed, then looks up Input_THR
+	g_transfer.apply();
+}
@@ -17,12 +17,20 @@
 namespace rc
 {
 
-static int16_t s_values[Input_Count] = { 0 };
+static int16_t  s_values[Input_Count] = { 0 };
+static uint16_t s_dirty     = 0; // one bit per input
+static uint16_t s_processed = 0; // one bit per input
 
 
 void setInput(Input p_input, int16_t p_value)
 {
-	s_values[p_input] = p_value;
+	uint16_t bit = static_cast<uint16_t>(1) << p_input;
+	if (s_values[p_input] != p_value || (s_processed & bit))
+	{
+		s_values[p_input] = p_value;
+		s_dirty     |= bit;
+		s_processed &= ~bit;
+	}
 }
 
 
@@ -32,5 +40,23 @@ int16_t getInput(Input p_input)
 }
 
 
+uint16_t getDirtyInputs()
+{
+	return s_dirty;
+}
+
+
+void clearDirtyInputs(uint16_t p_inputs)
+{
+	s_dirty &= ~p_inputs;
+}
+
+
+void markInputsProcessed(uint16_t p_inputs)
+{
+	s_processed |= p_inputs;
+}
+
+
 // namespace end
 }
@@ -41,7 +41,7 @@ namespace rc
 	};
 	
 	
-	/*! \brief Sets value for a certain input.
+	/*! \brief Sets value for a certain input, marks the input dirty if the value changed.
 	    \param p_input Input to set value of.
 	    \param p_value Value to set, range 140% [-358 - 358].*/
 	void setInput(Input p_input, int16_t p_value);
@@ -50,6 +50,19 @@ namespace rc
 	    \param p_input Input to get value of.*/
 	int16_t getInput(Input p_input);
 	
+	/*! \brief Gets the inputs which were changed by setInput since their dirty flag was cleared.
+	    \return Dirty flags, bit n is set if Input n is dirty.*/
+	uint16_t getDirtyInputs();
+	
+	/*! \brief Clears dirty flags, see Pipeline for the user of these.
+	    \param p_inputs Flags to clear, bit n clears Input n.*/
+	void clearDirtyInputs(uint16_t p_inputs);
+	
+	/*! \brief Marks inputs as holding a processed value, the next setInput marks them dirty even if
+	           it sets the same value. The raw value may coincide with the processed one.
+	    \param p_inputs Inputs to mark, bit n marks Input n.*/
+	void markInputsProcessed(uint16_t p_inputs);
+	
 }
 
 #endif // INC_RC_INPUT_H
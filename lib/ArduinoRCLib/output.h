@@ -52,6 +52,8 @@ namespace rc
 		Output_GYR3, //!< Gyro gain output 3 (Elevator)
 		Output_GEAR, //!< Landing gear output
 		Output_DOOR, //!< Landing gear doors output
+		Output_TRK1, //!< Track output 1, left track
+		Output_TRK2, //!< Track output 2, right track
 		
 		Output_Count,
 		Output_None //!< No output, special case
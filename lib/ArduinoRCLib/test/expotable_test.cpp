@@ -0,0 +1,132 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** expotable_test.cpp
+** Host test and benchmark of the Expo lookup tables
+**
+** For every expo value the table has to return exactly what interpolation
+** returns, for every input in [-358 - 358] (values beyond full stick are
+** interpolated). Also checks table sharing and a full cache, and measures the
+** cycles per apply() with and without a table, the best of five runs. The
+** cache is opt-in, build and run from this directory:
+**
+**   g++ -std=gnu++11 -O2 -DEXPOTABLE_CACHE_SIZE=2 -Ihost -I.. expotable_test.cpp ../Expo.cpp ../ExpoTable.cpp ../InputModifier.cpp ../input.cpp -o expotable_test
+**   ./expotable_test
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <stdio.h>
+
+#include <cycles.h>
+#include <Expo.h>
+
+#if EXPOTABLE_CACHE_SIZE != 2
+#error build with -DEXPOTABLE_CACHE_SIZE=2
+#endif
+
+
+static volatile int16_t s_sink;
+
+static double measure(const rc::Expo& p_expo)
+{
+	double best = 0;
+	for (int run = 0; run < 5; ++run)
+	{
+		double start = cycles();
+		for (int repeat = 0; repeat < 100; ++repeat)
+		{
+			for (int16_t value = -256; value <= 256; ++value)
+			{
+				s_sink = p_expo.apply(value);
+			}
+		}
+		double perApply = (cycles() - start) / (100.0 * 513.0);
+		if (run == 0 || perApply < best)
+		{
+			best = perApply;
+		}
+	}
+	return best;
+}
+
+
+int main()
+{
+	bool ok = true;
+	
+	// exact match
+	rc::Expo interpolated;
+	rc::Expo table;
+	if (table.setUseTable(true) == false)
+	{
+		puts("no table");
+		return 1;
+	}
+	int mismatches = 0;
+	for (int expo = -100; expo <= 100; ++expo)
+	{
+		interpolated = static_cast<int8_t>(expo);
+		table        = static_cast<int8_t>(expo);
+		for (int16_t value = -358; value <= 358; ++value)
+		{
+			int16_t expected = interpolated.apply(value);
+			int16_t result   = table.apply(value);
+			if (result != expected && ++mismatches <= 10)
+			{
+				printf("expo %d, input %d: table %d, interpolation %d\n", expo, value, result, expected);
+			}
+		}
+	}
+	if (mismatches != 0)
+	{
+		printf("%d mismatches\n", mismatches);
+		ok = false;
+	}
+	
+	// objects with the same expo share a table, a third expo value finds the cache full
+	{
+		rc::Expo first(30);
+		rc::Expo second(30);
+		rc::Expo third(-40);
+		rc::Expo fourth(50);
+		table.setUseTable(false);
+		if (first.setUseTable(true) == false || second.setUseTable(true) == false ||
+		    third.setUseTable(true) == false)
+		{
+			puts("sharing: no table for 30 or -40");
+			ok = false;
+		}
+		if (fourth.setUseTable(true))
+		{
+			puts("sharing: got a third table from a cache of two");
+			ok = false;
+		}
+		
+		// once -40 is released, 50 takes its table
+		third.setUseTable(false);
+		if (fourth.setUseTable(true) == false || fourth.apply(128) != rc::Expo(50).apply(128))
+		{
+			puts("sharing: released table not reused");
+			ok = false;
+		}
+	}
+	
+	// benchmark
+	static const int8_t expos[] = { 0, 30, -30, 100 };
+	for (uint8_t i = 0; i < sizeof(expos); ++i)
+	{
+		interpolated = expos[i];
+		table        = expos[i];
+		table.setUseTable(true);
+		double interpolation = measure(interpolated);
+		double lookup        = measure(table);
+		printf("expo %4d: interpolation %5.1f, table %5.1f cycles per apply\n", expos[i], interpolation, lookup);
+	}
+	
+	puts(ok ? "ok" : "FAILED");
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,16 @@
+/* ---------------------------------------------------------------------------
+** Host stand-in for avr/pgmspace.h, flash is ordinary memory on the host.
+** -------------------------------------------------------------------------*/
+
+#ifndef INC_RC_TEST_PGMSPACE_H
+#define INC_RC_TEST_PGMSPACE_H
+
+#include <inttypes.h>
+#include <string.h>
+
+#define PROGMEM
+#define pgm_read_byte(address) (*reinterpret_cast<const uint8_t*>(address))
+#define pgm_read_word(address) (*reinterpret_cast<const uint16_t*>(address))
+#define memcpy_P memcpy
+
+#endif // INC_RC_TEST_PGMSPACE_H
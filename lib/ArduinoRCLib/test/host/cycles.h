@@ -0,0 +1,25 @@
+/* ---------------------------------------------------------------------------
+** Cycle counter for the host tests and benchmarks, the time stamp counter on
+** x86, nanoseconds elsewhere. Only the ratio between two measurements means
+** something, the AVR has no cache, no pipeline to speak of and no FPU.
+** -------------------------------------------------------------------------*/
+
+#ifndef INC_RC_TEST_CYCLES_H
+#define INC_RC_TEST_CYCLES_H
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+inline double cycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return static_cast<double>(__rdtsc());
+#else
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+#endif // INC_RC_TEST_CYCLES_H
@@ -0,0 +1,321 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** pipeline_test.cpp
+** Host test of Pipeline: dependency loops and incremental evaluation
+**
+** Two mixes feeding each other can't be sorted, compile() fails and run()
+** must not touch the input system: not the stages in the loop, nor a curve
+** that was sorted before the loop was found.
+**
+** The stages of the pipeline example run over 200000 random frames and the
+** results are compared with the stages applied one by one on the raw values.
+** Frames leave inputs unchanged, rewrite them with the same raw value or not
+** at all, write a raw value equal to the processed value of an input that is
+** modified in place, toggle throttle hold and change a parameter followed by
+** invalidate(). getEvaluatedCount() and getSkippedCount() are checked for
+** the cases where the number of stages to run is known. Build and run from
+** this directory:
+**
+**   g++ -std=gnu++11 -O2 -Ihost -I.. pipeline_test.cpp ../Pipeline.cpp ../Curve.cpp ../DualRates.cpp ../Expo.cpp ../ExpoTable.cpp ../InputToInputMix.cpp ../ThrottleHold.cpp ../InputModifier.cpp ../InputProcessor.cpp ../InputSource.cpp ../input.cpp ../util.cpp -o pipeline_test
+**   ./pipeline_test
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Curve.h>
+#include <DualRates.h>
+#include <Expo.h>
+#include <InputToInputMix.h>
+#include <Pipeline.h>
+#include <ThrottleHold.h>
+
+
+static bool testLoop()
+{
+	bool ok = true;
+	
+	rc::Curve           curve(rc::Curve::DefaultCurve_Linear, rc::Input_AIL, rc::Input_FLP);
+	rc::InputToInputMix throttleToRudder(50, false, rc::Input_THR, rc::Input_RUD);
+	rc::InputToInputMix rudderToThrottle(50, false, rc::Input_RUD, rc::Input_THR);
+	
+	rc::Pipeline pipeline;
+	pipeline.add(curve);
+	pipeline.add(throttleToRudder);
+	pipeline.add(rudderToThrottle);
+	
+	rc::setInput(rc::Input_AIL, 100);
+	rc::setInput(rc::Input_FLP, 77);
+	rc::setInput(rc::Input_THR, 10);
+	rc::setInput(rc::Input_RUD, 20);
+	
+	if (pipeline.compile())
+	{
+		puts("compile() accepted a loop");
+		ok = false;
+	}
+	if (pipeline.getCompiledCount() != 0)
+	{
+		printf("%d stages compiled\n", pipeline.getCompiledCount());
+		ok = false;
+	}
+	
+	pipeline.run();
+	if (pipeline.getEvaluatedCount() != 0)
+	{
+		printf("run() evaluated %d stages\n", pipeline.getEvaluatedCount());
+		ok = false;
+	}
+	if (rc::getInput(rc::Input_FLP) != 77 || rc::getInput(rc::Input_THR) != 10 || rc::getInput(rc::Input_RUD) != 20)
+	{
+		printf("run() wrote the inputs: FLP %d THR %d RUD %d\n",
+		       rc::getInput(rc::Input_FLP), rc::getInput(rc::Input_THR), rc::getInput(rc::Input_RUD));
+		ok = false;
+	}
+	
+	// without the loop the curve runs again
+	rc::Pipeline fixed;
+	fixed.add(curve);
+	fixed.add(throttleToRudder);
+	if (fixed.compile() == false || fixed.getCompiledCount() != 2)
+	{
+		puts("compile() failed without a loop");
+		ok = false;
+	}
+	fixed.run();
+	if (rc::getInput(rc::Input_FLP) != 100)
+	{
+		printf("curve result %d, expected 100\n", rc::getInput(rc::Input_FLP));
+		ok = false;
+	}
+	
+	return ok;
+}
+
+
+static int randomBetween(int p_min, int p_max)
+{
+	return p_min + rand() % (p_max - p_min + 1);
+}
+
+
+// the stages of the pipeline example
+static rc::DualRates       s_ailDR(80, rc::Input_AIL);
+static rc::Expo            s_ailExpo(-30, rc::Input_AIL);
+static rc::Expo            s_eleExpo(-20, rc::Input_ELE);
+static rc::InputToInputMix s_ailToThr(5, true, rc::Input_AIL, rc::Input_THR);
+static rc::Curve           s_thrCurve(rc::Curve::DefaultCurve_Linear, rc::Input_THR, rc::Input_THR);
+static rc::Curve           s_pitCurve(rc::Curve::DefaultCurve_HalfLinear, rc::Input_THR, rc::Input_PIT);
+static rc::ThrottleHold    s_throttleHold;
+static bool                s_hold = false;
+
+// the same curves without a destination, applying them doesn't write to the input system
+static rc::Curve s_thrReference(rc::Curve::DefaultCurve_Linear);
+static rc::Curve s_pitReference(rc::Curve::DefaultCurve_HalfLinear);
+
+static const rc::Input s_rawInputs[3] = { rc::Input_AIL, rc::Input_ELE, rc::Input_THR };
+
+
+// compares the pipeline results with the stages applied one by one on the raw values
+static bool checkResults(const int16_t* p_raw, const char* p_step)
+{
+	int16_t ail = s_ailDR.apply(s_ailExpo.apply(p_raw[0]));
+	int16_t ele = s_eleExpo.apply(p_raw[1]);
+	int16_t thr = s_throttleHold.apply(s_hold, s_thrReference.apply(s_ailToThr.apply(ail, p_raw[2])));
+	int16_t pit = s_pitReference.apply(thr);
+	if (rc::getInput(rc::Input_AIL) == ail && rc::getInput(rc::Input_ELE) == ele &&
+	    rc::getInput(rc::Input_THR) == thr && rc::getInput(rc::Input_PIT) == pit)
+	{
+		return true;
+	}
+	printf("%s: raw %d %d %d, AIL %d/%d ELE %d/%d THR %d/%d PIT %d/%d (pipeline/expected)\n",
+	       p_step, p_raw[0], p_raw[1], p_raw[2],
+	       rc::getInput(rc::Input_AIL), ail, rc::getInput(rc::Input_ELE), ele,
+	       rc::getInput(rc::Input_THR), thr, rc::getInput(rc::Input_PIT), pit);
+	return false;
+}
+
+
+// p_evaluated < 0: only checks that every stage was either evaluated or skipped
+static bool checkCounts(const rc::Pipeline& p_pipeline, int p_evaluated, const char* p_step)
+{
+	uint8_t evaluated = p_pipeline.getEvaluatedCount();
+	uint8_t skipped   = p_pipeline.getSkippedCount();
+	if (evaluated + skipped == p_pipeline.getCompiledCount() && (p_evaluated < 0 || evaluated == p_evaluated))
+	{
+		return true;
+	}
+	printf("%s: %d evaluated, %d skipped, expected %d of %d evaluated\n",
+	       p_step, evaluated, skipped, p_evaluated, p_pipeline.getCompiledCount());
+	return false;
+}
+
+
+static void writeRaw(const int16_t* p_raw)
+{
+	for (uint8_t i = 0; i < 3; ++i)
+	{
+		rc::setInput(s_rawInputs[i], p_raw[i]);
+	}
+}
+
+
+static bool testIncremental()
+{
+	bool ok = true;
+	
+	rc::Pipeline pipeline;
+	pipeline.add(s_pitCurve);
+	pipeline.add(s_ailToThr);
+	pipeline.add(s_thrCurve);
+	pipeline.add(s_throttleHold, s_hold);
+	pipeline.add(s_ailExpo);
+	pipeline.add(s_ailDR);
+	pipeline.add(s_eleExpo);
+	if (pipeline.compile() == false || pipeline.getCompiledCount() != 7)
+	{
+		puts("compile() failed");
+		return false;
+	}
+	
+	// the first run evaluates everything
+	int16_t raw[3] = { 150, -50, 20 };
+	writeRaw(raw);
+	pipeline.run();
+	ok &= checkResults(raw, "first run");
+	ok &= checkCounts(pipeline, 7, "first run");
+	
+	// nothing written, only throttle hold runs
+	pipeline.run();
+	ok &= checkResults(raw, "no input written");
+	ok &= checkCounts(pipeline, 1, "no input written");
+	
+	// the same raw values again, dirty because the inputs hold the processed values, but unchanged
+	writeRaw(raw);
+	pipeline.run();
+	ok &= checkResults(raw, "same raw values");
+	ok &= checkCounts(pipeline, 1, "same raw values");
+	
+	// elevator only: its expo and throttle hold
+	raw[1] = -120;
+	writeRaw(raw);
+	pipeline.run();
+	ok &= checkResults(raw, "elevator changed");
+	ok &= checkCounts(pipeline, 2, "elevator changed");
+	
+	// throttle hold on and off: the hold stage and the pitch curve reading throttle
+	s_hold = true;
+	pipeline.run();
+	ok &= checkResults(raw, "hold on");
+	ok &= checkCounts(pipeline, 2, "hold on");
+	s_hold = false;
+	pipeline.run();
+	ok &= checkResults(raw, "hold off");
+	ok &= checkCounts(pipeline, 2, "hold off");
+	
+	// a raw aileron value equal to its processed value still counts as a change
+	raw[0] = rc::getInput(rc::Input_AIL);
+	if (raw[0] == 150)
+	{
+		puts("aileron not modified in place");
+		ok = false;
+	}
+	writeRaw(raw);
+	pipeline.run();
+	ok &= checkResults(raw, "raw equals processed");
+	ok &= checkCounts(pipeline, -1, "raw equals processed");
+	
+	// parameters are not inputs, invalidate() makes the next run evaluate everything
+	s_eleExpo = 60;
+	pipeline.invalidate();
+	pipeline.run();
+	ok &= checkResults(raw, "expo changed");
+	ok &= checkCounts(pipeline, 7, "expo changed");
+	
+	// random frames
+	srand(1);
+	const long frames = 200000;
+	long frame      = 0;
+	long evaluated  = 0;
+	int  mismatches = 0;
+	for (; frame < frames; ++frame)
+	{
+		for (uint8_t i = 0; i < 3; ++i)
+		{
+			switch (rand() % 8)
+			{
+				case 0:
+				case 1:
+				case 2: // new value
+					raw[i] = static_cast<int16_t>(randomBetween(-256, 256));
+					rc::setInput(s_rawInputs[i], raw[i]);
+				break;
+				
+				case 3: // the processed value
+					raw[i] = rc::getInput(s_rawInputs[i]);
+					rc::setInput(s_rawInputs[i], raw[i]);
+				break;
+				
+				case 4:
+				case 5: // unchanged, written again
+					rc::setInput(s_rawInputs[i], raw[i]);
+				break;
+				
+				default: // unchanged, not written
+				break;
+			}
+		}
+		if (rand() % 10 == 0)
+		{
+			s_hold = !s_hold;
+		}
+		bool invalidated = rand() % 100 == 0;
+		if (invalidated)
+		{
+			uint8_t point = static_cast<uint8_t>(rand() % rc::Curve::PointCount);
+			int16_t value = static_cast<int16_t>(randomBetween(-256, 256));
+			switch (rand() % 7)
+			{
+				case 0: s_ailDR = static_cast<uint8_t>(randomBetween(0, 140)); break;
+				case 1: s_ailExpo = static_cast<int8_t>(randomBetween(-100, 100)); break;
+				case 2: s_eleExpo = static_cast<int8_t>(randomBetween(-100, 100)); break;
+				case 3: s_ailToThr.setMix(static_cast<int8_t>(randomBetween(-100, 100))); break;
+				case 4: s_thrCurve[point] = s_thrReference[point] = value; break;
+				case 5: s_pitCurve[point] = s_pitReference[point] = value; break;
+				default: s_throttleHold.setThrottle(value); break;
+			}
+			pipeline.invalidate();
+		}
+		
+		pipeline.run();
+		if (checkResults(raw, "random frame") == false)
+		{
+			ok = false;
+			if (++mismatches == 10)
+			{
+				break;
+			}
+		}
+		ok &= checkCounts(pipeline, invalidated ? 7 : -1, "random frame");
+		evaluated += pipeline.getEvaluatedCount();
+	}
+	printf("%ld random frames, %.2f of 7 stages evaluated per frame\n", frame, static_cast<double>(evaluated) / frame);
+	
+	return ok;
+}
+
+
+int main()
+{
+	bool ok = testLoop();
+	ok &= testIncremental();
+	
+	puts(ok ? "ok" : "FAILED");
+	return ok ? 0 : 1;
+}
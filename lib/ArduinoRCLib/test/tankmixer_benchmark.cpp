@@ -0,0 +1,88 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** tankmixer_benchmark.cpp
+** Host benchmark of the cycles per TankMixer mix
+**
+** Measures every mixing mode over the full stick range, the best of five
+** runs, and checks the outputs stay in range. There is no comparison with the
+** map() based mixing main.cpp used before: the host divides in hardware, the
+** AVR calls a 32 bit division routine of several hundred cycles for every
+** map(). Build and run from this directory:
+**
+**   g++ -std=gnu++11 -O2 -Ihost -I.. tankmixer_benchmark.cpp ../TankMixer.cpp ../input.cpp ../output.cpp ../util.cpp -o tankmixer_benchmark
+**   ./tankmixer_benchmark
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <stdio.h>
+
+#include <cycles.h>
+#include <TankMixer.h>
+
+
+static volatile int16_t s_sink;
+
+static double measure(const rc::TankMixer& p_mixer)
+{
+	double best = 0;
+	for (int run = 0; run < 5; ++run)
+	{
+		int16_t left  = 0;
+		int16_t right = 0;
+		double start = cycles();
+		for (int16_t throttle = -256; throttle <= 256; ++throttle)
+		{
+			for (int16_t steering = -256; steering <= 256; ++steering)
+			{
+				p_mixer.apply(throttle, steering, left, right);
+				s_sink = left;
+				s_sink = right;
+			}
+		}
+		double perMix = (cycles() - start) / (513.0 * 513.0);
+		if (run == 0 || perMix < best)
+		{
+			best = perMix;
+		}
+	}
+	return best;
+}
+
+
+int main()
+{
+	static const char* const names[rc::TankMixer::Mode_Count] = { "arcade", "tank", "pivot blend" };
+	bool ok = true;
+	
+	for (uint8_t mode = 0; mode < rc::TankMixer::Mode_Count; ++mode)
+	{
+		rc::TankMixer mixer(static_cast<rc::TankMixer::Mode>(mode));
+		
+		// outputs have to stay in range, even beyond full stick
+		int16_t left;
+		int16_t right;
+		for (int16_t throttle = -300; throttle <= 300; ++throttle)
+		{
+			for (int16_t steering = -300; steering <= 300; ++steering)
+			{
+				mixer.apply(throttle, steering, left, right);
+				if (left < -256 || left > 256 || right < -256 || right > 256)
+				{
+					printf("%s: %d %d out of range: %d %d\n", names[mode], throttle, steering, left, right);
+					ok = false;
+				}
+			}
+		}
+		
+		double perMix = measure(mixer);
+		printf("%-12s %6.1f cycles per mix\n", names[mode], perMix);
+	}
+	
+	puts(ok ? "ok" : "FAILED");
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** transferfunction_test.cpp
+** Host test of TransferFunction against the stage by stage chain
+**
+** The table is compared with DualRates, Expo and Curve applied one by one for
+** every input in [-358 - 358]: for the linear curve with every rate and expo,
+** and for 2000 random settings with random curves, half of them monotone.
+** With a shift of 0 the results have to be bit-exact. For shifts 1 to 3 the
+** largest error is printed, for the linear curve it is checked against the
+** limits documented in TransferFunction.h. Also checks that update() only
+** recalculates after a change.
+** Build and run from this directory:
+**
+**   g++ -std=gnu++11 -O2 -Ihost -I.. transferfunction_test.cpp ../TransferFunction.cpp ../DualRates.cpp ../Expo.cpp ../ExpoTable.cpp ../Curve.cpp ../InputModifier.cpp ../InputProcessor.cpp ../InputSource.cpp ../input.cpp ../util.cpp -o transferfunction_test
+**   ./transferfunction_test
+**
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Curve.h>
+#include <DualRates.h>
+#include <Expo.h>
+#include <TransferFunction.h>
+
+
+static int randomBetween(int p_min, int p_max)
+{
+	return p_min + rand() % (p_max - p_min + 1);
+}
+
+
+static int compare(uint8_t p_shift, const rc::DualRates& p_rates, const rc::Expo& p_expo, const rc::Curve& p_curve)
+{
+	int16_t table[TRANSFERFUNCTION_TABLE_SIZE(0)];
+	rc::TransferFunction function(table, p_shift);
+	function.setDualRates(p_rates);
+	function.setExpo(p_expo);
+	function.setCurve(p_curve);
+	function.update();
+	
+	int worst = 0;
+	for (int16_t value = -358; value <= 358; ++value)
+	{
+		int16_t expected = p_curve.apply(p_expo.apply(p_rates.apply(value)));
+		int error = abs(function.apply(value) - expected);
+		if (error > worst)
+		{
+			worst = error;
+		}
+	}
+	return worst;
+}
+
+
+int main()
+{
+	enum Kind { Kind_Linear100, Kind_Linear140, Kind_Monotone, Kind_Any, Kind_Count };
+	static const char* const names[Kind_Count] = { "linear, rate <= 100", "linear, rate <= 140", "monotone", "any curve" };
+	static const int limits[Kind_Count][4] = // -1: not checked
+	{
+		{ 0,  4,  6, 11 },
+		{ 0,  6,  9, 15 },
+		{ 0, -1, -1, -1 },
+		{ 0, -1, -1, -1 }
+	};
+	int worst[Kind_Count][4] = { { 0 } };
+	
+	// the linear curve, every rate and expo
+	rc::Curve linear;
+	for (int rate = 0; rate <= 140; ++rate)
+	{
+		for (int expo = -100; expo <= 100; ++expo)
+		{
+			rc::DualRates rates(static_cast<uint8_t>(rate));
+			rc::Expo      exponential(static_cast<int8_t>(expo));
+			for (uint8_t shift = 0; shift < 4; ++shift)
+			{
+				int error = compare(shift, rates, exponential, linear);
+				if (rate <= 100 && error > worst[Kind_Linear100][shift])
+				{
+					worst[Kind_Linear100][shift] = error;
+				}
+				if (error > worst[Kind_Linear140][shift])
+				{
+					worst[Kind_Linear140][shift] = error;
+				}
+			}
+		}
+	}
+	
+	// random curves
+	srand(1);
+	for (int run = 0; run < 2000; ++run)
+	{
+		Kind kind = (run & 1) == 0 ? Kind_Monotone : Kind_Any;
+		rc::DualRates rates(static_cast<uint8_t>(randomBetween(0, 140)));
+		rc::Expo      expo(static_cast<int8_t>(randomBetween(-100, 100)));
+		rc::Curve     curve;
+		int16_t point = -256;
+		for (uint8_t i = 0; i < rc::Curve::PointCount; ++i)
+		{
+			point = static_cast<int16_t>(kind == Kind_Monotone ? randomBetween(point, point + (256 - point) / 2) : randomBetween(-256, 256));
+			curve[i] = point;
+		}
+		
+		for (uint8_t shift = 0; shift < 4; ++shift)
+		{
+			int error = compare(shift, rates, expo, curve);
+			if (error > worst[kind][shift])
+			{
+				worst[kind][shift] = error;
+			}
+		}
+	}
+	
+	bool ok = true;
+	printf("largest error        shift 0   1   2   3\n");
+	for (uint8_t kind = 0; kind < Kind_Count; ++kind)
+	{
+		printf("%-20s %7d %3d %3d %3d\n", names[kind], worst[kind][0], worst[kind][1], worst[kind][2], worst[kind][3]);
+		for (uint8_t shift = 0; shift < 4; ++shift)
+		{
+			if (limits[kind][shift] >= 0 && worst[kind][shift] > limits[kind][shift])
+			{
+				printf("%s, shift %d: error %d, limit %d\n", names[kind], shift, worst[kind][shift], limits[kind][shift]);
+				ok = false;
+			}
+		}
+	}
+	
+	// update() only recalculates after a parameter changed
+	{
+		int16_t table[TRANSFERFUNCTION_TABLE_SIZE(0)];
+		rc::DualRates rates(80);
+		rc::Expo      expo(30);
+		rc::TransferFunction function(table, 0);
+		function.setDualRates(rates);
+		function.setExpo(expo);
+		bool first  = function.update();
+		bool second = function.update();
+		expo = 40;
+		bool third  = function.update();
+		if (first == false || second || third == false || function.apply(200) != expo.apply(rates.apply(200)))
+		{
+			printf("update(): %d %d %d\n", first, second, third);
+			ok = false;
+		}
+	}
+	
+	puts(ok ? "ok" : "FAILED");
+	return ok ? 0 : 1;
+}
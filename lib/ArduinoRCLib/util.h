@@ -85,6 +85,16 @@ namespace rc
 	
 	/*! \brief Sets timings according to JR standards, center 1500, travel 600.*/
 	void loadJR();
+	
+	/*! \brief Gets the address of an object, even if its class overloads the address-of operator
+	           (DualRates, Expo).
+	    \param p_object Object to get the address of.
+	    \return Address of p_object.*/
+	template <typename T>
+	inline const T* addressOf(const T& p_object)
+	{
+		return reinterpret_cast<const T*>(&reinterpret_cast<const char&>(p_object));
+	}
 }
 
 #endif // INC_RC_UTIL_H
@@ -0,0 +1,37 @@
+#ifndef INC_ISRPROFILE_H
+#define INC_ISRPROFILE_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** IsrProfile.h
+** Interrupt profiling hooks for libraries that don't depend on ArduinoRCLib
+**
+** Interrupt service routines call ISR_PROFILE_BEGIN(latency) as their first
+** and ISR_PROFILE_END(vector) as their last statement, vector being one of
+** rc::IsrProfiler::Vector without the class prefix, ie: Vector_PinChange.
+** Routines that can't tell their latency pass ISR_PROFILE_NO_LATENCY.
+**
+** Only with ISR_PROFILER defined for the whole build this includes
+** IsrProfiler.h of ArduinoRCLib, which implements the macros. Otherwise they
+** are empty here, nothing is left in the firmware and no other library is
+** needed. This is the only place the empty macros are defined, IsrProfiler.h
+** includes this header too.
+** -------------------------------------------------------------------------*/
+
+#define ISR_PROFILE_NO_LATENCY 0xFFFF
+
+#ifdef ISR_PROFILER
+
+#include <IsrProfiler.h>
+
+#else // ISR_PROFILER
+
+#define ISR_PROFILE_BEGIN(p_latency)
+#define ISR_PROFILE_END(p_vector)
+
+#endif // ISR_PROFILER
+
+#endif // INC_ISRPROFILE_H
@@ -51,6 +51,14 @@ Copyright 2010-2014 Michael Schwager (aka, "GreyGnome")
  *		getInterruptedPin()
  *	Note: If you have multiple pins that are triggering interrupts and they are sufficiently fast,
  *	you will not be able to find all the pins that interrupted.
+ *
+ *	If your function needs to know when the pin changed, let it take the time instead:
+ *		void userFunc(unsigned long timestamp) {
+ *		  ...your code here...
+ *		}
+ *	The time (micros(), or PCINT_TIMESTAMP_FUNCTION) is read once per interrupt, before any function
+ *	runs, so all pins that changed together get the same timestamp, no matter how long the functions
+ *	called before them take.
 */
 
 //
@@ -106,6 +114,8 @@ Copyright 2010-2014 Michael Schwager (aka, "GreyGnome")
 // #define NO_PIN_NUMBER       // to indicate that you don't need the arduinoPin
 // #define DISABLE_PCINT_MULTI_SERVICE // to limit the handler to servicing a single interrupt per invocation.
 // #define GET_PCINT_VERSION   // to enable the uint16_t getPCIintVersion () function.
+// #define PCINT_TIMESTAMP_FUNCTION myCounter // time source for timed handlers (default: micros), must
+//                                            // return unsigned long and be callable from an ISR.
 // The following is intended for testing purposes.  If defined, then a whole host of static variables can be read
 // in your interrupt subroutine.  It is not defined by default, and you DO NOT want to define this in
 // Production code!:
@@ -128,6 +138,7 @@ Copyright 2010-2014 Michael Schwager (aka, "GreyGnome")
 #include <Arduino.h>
 #include <new.h>
 #include <wiring_private.h> // cbi and sbi defined here
+#include <IsrProfile.h> // empty unless ISR_PROFILER is defined
 
 #undef DEBUG
 
@@ -185,6 +196,11 @@ Copyright 2010-2014 Michael Schwager (aka, "GreyGnome")
 #define PCgetArduinoPin() PCintPort::getArduinoPin()
 
 typedef void (*PCIntvoidFuncPtr)(void);
+typedef void (*PCIntTimedFuncPtr)(unsigned long timestamp);
+
+#ifndef PCINT_TIMESTAMP_FUNCTION
+#define PCINT_TIMESTAMP_FUNCTION micros
+#endif
 
 class PCintPort {
 public:
@@ -198,17 +214,20 @@ public:
 	PCICRbit(1 << pcindex),
 	portRisingPins(0),
 	portFallingPins(0),
+	portTimedPins(0),
 	firstPin(NULL)
 #ifdef PINMODE
 	,intrCount(0)
 #endif
 	{
+		for (uint8_t i=0; i < 8; i++) pinByBit[i]=NULL;
 		#ifdef FLASH
 		ledsetup();
 		#endif
 	}
 	volatile	uint8_t&		portInputReg;
 	static		int8_t attachInterrupt(uint8_t pin, PCIntvoidFuncPtr userFunc, int mode);
+	static		int8_t attachInterrupt(uint8_t pin, PCIntTimedFuncPtr userFunc, int mode);
 	static		void detachInterrupt(uint8_t pin);
 	INLINE_PCINT void PCint();
 	static volatile uint8_t curr;
@@ -243,21 +262,28 @@ protected:
 	public:
 		PCintPin() :
 		PCintFunc((PCIntvoidFuncPtr)NULL),
+		PCintTimedFunc((PCIntTimedFuncPtr)NULL),
 		mode(0) {}
 		PCIntvoidFuncPtr PCintFunc;
+		PCIntTimedFuncPtr PCintTimedFunc; // set instead of PCintFunc for timed handlers
 		uint8_t 	mode;
 		uint8_t		mask;
 		uint8_t arduinoPin;
 		PCintPin* next;
 	};
-	void 		enable(PCintPin* pin, PCIntvoidFuncPtr userFunc, uint8_t mode);
-	int8_t		addPin(uint8_t arduinoPin,PCIntvoidFuncPtr userFunc, uint8_t mode);
+	static		int8_t attach(uint8_t pin, PCIntvoidFuncPtr userFunc, PCIntTimedFuncPtr timedFunc, int mode);
+	void 		enable(PCintPin* pin, PCIntvoidFuncPtr userFunc, PCIntTimedFuncPtr timedFunc, uint8_t mode);
+	int8_t		addPin(uint8_t arduinoPin,PCIntvoidFuncPtr userFunc, PCIntTimedFuncPtr timedFunc, uint8_t mode);
 	volatile	uint8_t&		portPCMask;
 	const		uint8_t			PCICRbit;
 	volatile	uint8_t			portRisingPins;
 	volatile	uint8_t			portFallingPins;
+	volatile	uint8_t			portTimedPins; // pins with a timed handler, the ISR only reads the time for them
 	volatile uint8_t		lastPinView;
 	PCintPin*	firstPin;
+	// The same pins, indexed by bit position. PCint() only visits the pins that changed, so
+	// its cost no longer grows with the number of attached pins.
+	PCintPin*	pinByBit[8];
 };
 
 #ifndef LIBCALL_PINCHANGEINT // LIBCALL_PINCHANGEINT ***********************************************
@@ -284,6 +310,10 @@ volatile uint8_t PCintPort::pcint_multi=0;
 volatile uint8_t PCintPort::PCIFRbug=0;
 #endif
 
+// Position of the lowest set bit of a nibble, used by PCint() to find the changed pins
+// (entry 0 is never used).
+static const uint8_t PCintLowestBit[16] PROGMEM = { 0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0 };
+
 #ifdef FLASH
 #define PINLED 13
 volatile uint8_t *led_port;
@@ -387,11 +417,14 @@ static PCintPort *lookupPortNumToPort( int portNum ) {
 }
 
 
-void PCintPort::enable(PCintPin* p, PCIntvoidFuncPtr userFunc, uint8_t mode) {
+void PCintPort::enable(PCintPin* p, PCIntvoidFuncPtr userFunc, PCIntTimedFuncPtr timedFunc, uint8_t mode) {
 	// Enable the pin for interrupts by adding to the PCMSKx register.
 	// ...The final steps; at this point the interrupt is enabled on this pin.
 	p->mode=mode;
 	p->PCintFunc=userFunc;
+	p->PCintTimedFunc=timedFunc;
+	if (timedFunc != NULL) portTimedPins |= p->mask;
+	else portTimedPins &= ~p->mask;
 #ifndef NO_PORTJ_PINCHANGES
 	// A big shout out to jrhelbert for this fix! Thanks!!!
 	if ((p->arduinoPin == 14) || (p->arduinoPin == 15)) {
@@ -408,7 +441,7 @@ void PCintPort::enable(PCintPin* p, PCIntvoidFuncPtr userFunc, uint8_t mode) {
 	PCICR |= PCICRbit;
 }
 
-int8_t PCintPort::addPin(uint8_t arduinoPin, PCIntvoidFuncPtr userFunc, uint8_t mode)
+int8_t PCintPort::addPin(uint8_t arduinoPin, PCIntvoidFuncPtr userFunc, PCIntTimedFuncPtr timedFunc, uint8_t mode)
 {
 	PCintPin* tmp;
 
@@ -416,7 +449,7 @@ int8_t PCintPort::addPin(uint8_t arduinoPin, PCIntvoidFuncPtr userFunc, uint8_t
 	// Add to linked list, starting with firstPin. If pin already exists, just enable.
 	if (firstPin != NULL) {
 		do {
-			if (tmp->arduinoPin == arduinoPin) { enable(tmp, userFunc, mode); return(0); }
+			if (tmp->arduinoPin == arduinoPin) { enable(tmp, userFunc, timedFunc, mode); return(0); }
 			if (tmp->next == NULL) break;
 			tmp=tmp->next;
 		} while (true);
@@ -432,6 +465,9 @@ int8_t PCintPort::addPin(uint8_t arduinoPin, PCIntvoidFuncPtr userFunc, uint8_t
 
 	if (firstPin == NULL) firstPin=p;
 	else tmp->next=p; // NOTE that tmp cannot be NULL.
+	uint8_t bit=0;
+	while ((p->mask >> bit) != 1) bit++;
+	pinByBit[bit]=p;
 
 #ifdef DEBUG
 	Serial.print("addPin. pin given: "); Serial.print(arduinoPin, DEC);
@@ -440,7 +476,7 @@ int8_t PCintPort::addPin(uint8_t arduinoPin, PCIntvoidFuncPtr userFunc, uint8_t
 	Serial.print("userFunc addr: "); Serial.println((int)p->PCintFunc, HEX);
 #endif
 
-	enable(p, userFunc, mode);
+	enable(p, userFunc, timedFunc, mode);
 #ifdef DEBUG
 	Serial.print("addPin. pin given: "); Serial.print(arduinoPin, DEC), Serial.print (" pin stored: ");
 	int addr = (int) p;
@@ -453,10 +489,25 @@ int8_t PCintPort::addPin(uint8_t arduinoPin, PCIntvoidFuncPtr userFunc, uint8_t
  * attach an interrupt to a specific pin using pin change interrupts.
  */
 int8_t PCintPort::attachInterrupt(uint8_t arduinoPin, PCIntvoidFuncPtr userFunc, int mode)
+{
+	if (userFunc == NULL) return(-1);
+	return(attach(arduinoPin, userFunc, NULL, mode));
+}
+
+/*
+ * same, for a function that takes the time the pin changed.
+ */
+int8_t PCintPort::attachInterrupt(uint8_t arduinoPin, PCIntTimedFuncPtr userFunc, int mode)
+{
+	if (userFunc == NULL) return(-1);
+	return(attach(arduinoPin, NULL, userFunc, mode));
+}
+
+int8_t PCintPort::attach(uint8_t arduinoPin, PCIntvoidFuncPtr userFunc, PCIntTimedFuncPtr timedFunc, int mode)
 {
 	PCintPort *port;
 	uint8_t portNum = digitalPinToPort(arduinoPin);
-	if ((portNum == NOT_A_PORT) || (userFunc == NULL)) return(-1);
+	if (portNum == NOT_A_PORT) return(-1);
 
 	port=lookupPortNumToPort(portNum);
 	// Added by GreyGnome... must set the initial value of lastPinView for it to be correct on the 1st interrupt.
@@ -466,7 +517,7 @@ int8_t PCintPort::attachInterrupt(uint8_t arduinoPin, PCIntvoidFuncPtr userFunc,
 	Serial.print("attachInterrupt- pin: "); Serial.println(arduinoPin, DEC);
 #endif
 	// map pin to PCIR register
-	return(port->addPin(arduinoPin,userFunc,mode));
+	return(port->addPin(arduinoPin,userFunc,timedFunc,mode));
 }
 
 void PCintPort::detachInterrupt(uint8_t arduinoPin)
@@ -496,6 +547,7 @@ void PCintPort::detachInterrupt(uint8_t arduinoPin)
 #endif
 			if (port->portPCMask == 0) PCICR &= ~(port->PCICRbit);
 			port->portRisingPins &= ~current->mask; port->portFallingPins &= ~current->mask;
+			port->portTimedPins &= ~current->mask;
 			// TODO: This is removed until we can add code that frees memory.
 			// Note that in the addPin() function, above, we do not define a new pin if it was
 			// once already defined.
@@ -538,27 +590,33 @@ void PCintPort::PCint() {
 		#endif
 		lastPinView = PCintPort::curr;
 
-		PCintPin* p = firstPin;
-		while (p) {
-			// Trigger interrupt if the bit is high and it's set to trigger on mode RISING or CHANGE
-			// Trigger interrupt if the bit is low and it's set to trigger on mode FALLING or CHANGE
-			if (p->mask & changedPins) {
-				#ifndef NO_PIN_STATE
-				PCintPort::pinState=PCintPort::curr & p->mask ? HIGH : LOW;
-				#endif
-				#ifndef NO_PIN_NUMBER
-				PCintPort::arduinoPin=p->arduinoPin;
-				#endif
-				#ifdef PINMODE
-				PCintPort::pinmode=p->mode;
-				PCintPort::s_portRisingPins=portRisingPins;
-				PCintPort::s_portFallingPins=portFallingPins;
-				PCintPort::s_pmask=p->mask;
-				PCintPort::s_changedPins=changedPins;
-				#endif
-				p->PCintFunc();
-			}
-			p=p->next;
+		// one timestamp for all pins serviced in this pass, taken before any handler runs
+		unsigned long timestamp = 0;
+		if (changedPins & portTimedPins) timestamp = PCINT_TIMESTAMP_FUNCTION();
+
+		// Trigger interrupt if the bit is high and it's set to trigger on mode RISING or CHANGE
+		// Trigger interrupt if the bit is low and it's set to trigger on mode FALLING or CHANGE
+		while (changedPins) {
+			uint8_t bit = (changedPins & 0x0F) ?
+				pgm_read_byte(&PCintLowestBit[changedPins & 0x0F]) :
+				4 + pgm_read_byte(&PCintLowestBit[changedPins >> 4]);
+			PCintPin* p = pinByBit[bit];
+			#ifndef NO_PIN_STATE
+			PCintPort::pinState=PCintPort::curr & p->mask ? HIGH : LOW;
+			#endif
+			#ifndef NO_PIN_NUMBER
+			PCintPort::arduinoPin=p->arduinoPin;
+			#endif
+			#ifdef PINMODE
+			PCintPort::pinmode=p->mode;
+			PCintPort::s_portRisingPins=portRisingPins;
+			PCintPort::s_portFallingPins=portFallingPins;
+			PCintPort::s_pmask=p->mask;
+			PCintPort::s_changedPins=changedPins;
+			#endif
+			changedPins &= changedPins - 1; // clear the lowest set bit
+			if (p->PCintTimedFunc != NULL) p->PCintTimedFunc(timestamp);
+			else p->PCintFunc();
 		}
 	#ifndef DISABLE_PCINT_MULTI_SERVICE
 		pcifr = PCIFR & PCICRbit;
@@ -578,8 +636,10 @@ ISR(PCINT0_vect) {
 	#ifdef PINMODE
 	PCintPort::s_PORT='A';
 	#endif
+	ISR_PROFILE_BEGIN(ISR_PROFILE_NO_LATENCY);
 	PCintPort::curr = portA.portInputReg;
 	portA.PCint();
+	ISR_PROFILE_END(Vector_PinChange);
 }
 #define PORTBVECT PCINT1_vect
 #define PORTCVECT PCINT2_vect
@@ -595,8 +655,10 @@ ISR(PORTBVECT) {
 	#ifdef PINMODE
 	PCintPort::s_PORT='B';
 	#endif
+	ISR_PROFILE_BEGIN(ISR_PROFILE_NO_LATENCY);
 	PCintPort::curr = portB.portInputReg;
 	portB.PCint();
+	ISR_PROFILE_END(Vector_PinChange);
 }
 #endif
 
@@ -605,8 +667,10 @@ ISR(PORTCVECT) {
 	#ifdef PINMODE
 	PCintPort::s_PORT='C';
 	#endif
+	ISR_PROFILE_BEGIN(ISR_PROFILE_NO_LATENCY);
 	PCintPort::curr = portC.portInputReg;
 	portC.PCint();
+	ISR_PROFILE_END(Vector_PinChange);
 }
 #endif
 
@@ -615,8 +679,10 @@ ISR(PORTDVECT){
 	#ifdef PINMODE
 	PCintPort::s_PORT='D';
 	#endif
+	ISR_PROFILE_BEGIN(ISR_PROFILE_NO_LATENCY);
 	PCintPort::curr = portD.portInputReg;
 	portD.PCint();
+	ISR_PROFILE_END(Vector_PinChange);
 }
 #endif
 
@@ -626,8 +692,10 @@ ISR(PCINT1_vect) {
 	#ifdef PINMODE
 	PCintPort::s_PORT='J';
 	#endif
+	ISR_PROFILE_BEGIN(ISR_PROFILE_NO_LATENCY);
 	PCintPort::curr = portJ.portInputReg;
 	portJ.PCint();
+	ISR_PROFILE_END(Vector_PinChange);
 }
 #endif
 
@@ -636,8 +704,10 @@ ISR(PCINT2_vect){
 	#ifdef PINMODE
 	PCintPort::s_PORT='K';
 	#endif
+	ISR_PROFILE_BEGIN(ISR_PROFILE_NO_LATENCY);
 	PCintPort::curr = portK.portInputReg;
 	portK.PCint();
+	ISR_PROFILE_END(Vector_PinChange);
 }
 #endif
 
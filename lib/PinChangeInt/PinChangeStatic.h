@@ -0,0 +1,183 @@
+// This file is part of the PinChangeInt library for the Arduino.  It binds pin change interrupt
+// handlers at compile time, for the ATmega168/328 based Arduinos.
+
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * QUICKSTART
+ *
+ * PCintPort::attachInterrupt() allocates a PCintPin with new for every pin and calls the handlers
+ * through function pointers. When the pins and their handlers are known when compiling, list them
+ * in a PinChangePort instead. Everything is resolved by the compiler: the masks are constants, the
+ * handlers can be inlined into the ISR and nothing is allocated.
+ *
+ *		void onSteering() { ... }
+ *		void onThrottle(unsigned long timestamp) { ... }
+ *
+ *		typedef PinChangePort< PinChange<2, onSteering>, TimedPinChange<3, onThrottle, CHANGE> > ReceiverPins;
+ *		PINCHANGE_ISR(PCINT2_vect, ReceiverPins);
+ *
+ *		void setup() {
+ *		  pinMode(2, INPUT); pinMode(3, INPUT);
+ *		  ReceiverPins::begin();
+ *		}
+ *
+ * All pins of a PinChangePort must be on the same port, and PINCHANGE_ISR must name the vector of
+ * that port: PCINT2_vect for pins 0 - 7, PCINT0_vect for pins 8 - 13, PCINT1_vect for pins 14 - 19
+ * (A0 - A5). The vector is taken by this file, so don't use PinChangeInt.h for that port, or define
+ * the matching NO_PORTx_PINCHANGES before including it.
+ *
+ * The mode (RISING, FALLING or CHANGE, default CHANGE) is the last template parameter. PinChange
+ * handlers take no arguments, TimedPinChange handlers take the time of the change: read once per
+ * interrupt with PCINT_TIMESTAMP_FUNCTION (micros() by default), and only when the port has timed
+ * handlers. Handlers run in the order they are listed.
+ */
+
+#ifndef PinChangeStatic_h
+#define	PinChangeStatic_h
+
+#include <Arduino.h>
+
+#if !defined(__AVR_ATmega328P__) && !defined(__AVR_ATmega328__) && !defined(__AVR_ATmega168__) && \
+	!defined(__AVR_ATmega168P__) && !defined(__AVR_ATmega88__) && !defined(__AVR_ATmega48__)
+#error "PinChangeStatic.h only knows the pin mapping of the ATmega48/88/168/328"
+#endif
+
+#ifndef PCINT_TIMESTAMP_FUNCTION
+#define PCINT_TIMESTAMP_FUNCTION micros
+#endif
+
+/* Pin to interrupt map, ATmega328:
+* D0-D7 = PCINT 16-23 = PCIR2 = PD = PCIE2 = pcmsk2
+* D8-D13 = PCINT 0-5 = PCIR0 = PB = PCIE0 = pcmsk0
+* A0-A5 (D14-D19) = PCINT 8-13 = PCIR1 = PC = PCIE1 = pcmsk1
+*/
+template <uint8_t PIN>
+struct PinChangePin {
+	static_assert(PIN < 20, "not a pin change interrupt pin");
+	static const uint8_t Port = PIN < 8 ? 2 : (PIN < 14 ? 0 : 1); // PCICR bit, and PCMSKx
+	static const uint8_t Mask = 1 << (PIN < 8 ? PIN : (PIN < 14 ? PIN - 8 : PIN - 14));
+};
+
+template <uint8_t PIN, void (*Handler)(), uint8_t MODE = CHANGE>
+struct PinChange {
+	static const uint8_t Port = PinChangePin<PIN>::Port;
+	static const uint8_t Mask = PinChangePin<PIN>::Mask;
+	static const uint8_t Mode = MODE;
+	static const bool Timed = false;
+
+	static inline void dispatch(uint8_t changedPins, unsigned long) {
+		if (changedPins & Mask) Handler();
+	}
+};
+
+template <uint8_t PIN, void (*Handler)(unsigned long), uint8_t MODE = CHANGE>
+struct TimedPinChange {
+	static const uint8_t Port = PinChangePin<PIN>::Port;
+	static const uint8_t Mask = PinChangePin<PIN>::Mask;
+	static const uint8_t Mode = MODE;
+	static const bool Timed = true;
+
+	static inline void dispatch(uint8_t changedPins, unsigned long timestamp) {
+		if (changedPins & Mask) Handler(timestamp);
+	}
+};
+
+// combined masks of a list of bindings, evaluated by the compiler
+template <class... Pins>
+struct PinChangeMasks {
+	static const uint8_t All = 0;
+	static const uint8_t Rising = 0;
+	static const uint8_t Falling = 0;
+	static const bool Timed = false;
+	static const bool Distinct = true;
+	template <uint8_t PORT> struct OnPort { static const bool value = true; };
+};
+
+template <class First, class... Rest>
+struct PinChangeMasks<First, Rest...> {
+	static const uint8_t All = First::Mask | PinChangeMasks<Rest...>::All;
+	static const uint8_t Rising = (First::Mode == FALLING ? 0 : First::Mask) | PinChangeMasks<Rest...>::Rising;
+	static const uint8_t Falling = (First::Mode == RISING ? 0 : First::Mask) | PinChangeMasks<Rest...>::Falling;
+	static const bool Timed = First::Timed || PinChangeMasks<Rest...>::Timed;
+	static const bool Distinct = (First::Mask & PinChangeMasks<Rest...>::All) == 0 && PinChangeMasks<Rest...>::Distinct;
+	template <uint8_t PORT> struct OnPort {
+		static const bool value = First::Port == PORT && PinChangeMasks<Rest...>::template OnPort<PORT>::value;
+	};
+};
+
+template <class First, class... Rest>
+class PinChangePort {
+public:
+	typedef PinChangeMasks<First, Rest...> Masks;
+	static const uint8_t Port = First::Port;
+
+	static_assert(Masks::template OnPort<Port>::value, "all pins of a PinChangePort must be on the same port");
+	static_assert(Masks::Distinct, "a pin is listed twice");
+
+	// enables the interrupt of all listed pins, call it after setting the pin modes
+	static void begin() {
+		uint8_t oldSREG = SREG;
+		cli();
+		lastPinView = read();
+		mask() |= Masks::All;
+		PCIFR = _BV(Port); // forget changes from before
+		PCICR |= _BV(Port);
+		SREG = oldSREG;
+	}
+
+	static void end() {
+		uint8_t oldSREG = SREG;
+		cli();
+		mask() &= ~Masks::All;
+		if (mask() == 0) PCICR &= ~_BV(Port);
+		SREG = oldSREG;
+	}
+
+	// the body of the ISR, see PINCHANGE_ISR
+	static inline void service() {
+		uint8_t curr = read();
+		uint8_t changedPins = (curr ^ lastPinView) & ((Masks::Rising & curr) | (Masks::Falling & ~curr));
+		lastPinView = curr;
+
+		unsigned long timestamp = Masks::Timed ? PCINT_TIMESTAMP_FUNCTION() : 0;
+
+		// C++11 has no fold expressions, the initializer list calls each dispatch() in order
+		int expand[] = { (First::dispatch(changedPins, timestamp), 0), (Rest::dispatch(changedPins, timestamp), 0)... };
+		(void)expand;
+	}
+
+private:
+	static inline uint8_t read() {
+		return Port == 0 ? PINB : (Port == 1 ? PINC : PIND);
+	}
+
+	static inline volatile uint8_t& mask() {
+		return Port == 0 ? PCMSK0 : (Port == 1 ? PCMSK1 : PCMSK2);
+	}
+
+	static uint8_t lastPinView;
+};
+
+template <class First, class... Rest>
+uint8_t PinChangePort<First, Rest...>::lastPinView = 0;
+
+#define PINCHANGE_ISR(vector, ...) \
+ISR(vector) \
+{ \
+	__VA_ARGS__::service(); \
+}
+
+#endif // #ifndef PinChangeStatic_h
@@ -0,0 +1,137 @@
+// PCintBenchmark: cycles spent in PCintPort::PCint() with 1, 4 and 8 attached pins, compared to
+// the linked list walk the ISR used before the bit-indexed table.
+//
+// The pins are attached to private PCintPort instances whose mask register is a plain variable,
+// so no pin change interrupt is enabled and no pin is touched; PCint() is called directly with a
+// made-up port value. Timer1 runs at the CPU clock while measuring, the figures below include
+// the call and the loop around it, which are the same for both versions.
+//
+// Output, one line per attached pin count, each case as "table <cycles> list <cycles>":
+//   pins: 8  none changed: ...  one changed: ...  all changed: ...
+// "one changed" uses the last attached pin (the highest bit), the worst case for the table.
+
+#include <PinChangeInt.h>
+
+#define CALLS 32
+
+volatile uint16_t handlerCalls = 0;
+
+void onChange() {
+	handlerCalls++;
+}
+
+volatile uint8_t benchMask = 0; // stands in for PCMSKx
+
+class BenchPort : public PCintPort {
+public:
+	BenchPort() : PCintPort(4, 2, benchMask) {}
+	void add(uint8_t arduinoPin) {
+		addPin(arduinoPin, onChange, NULL, CHANGE);
+		lastPinView=0;
+	}
+	// PCint() as it was before the bit-indexed table
+	void listWalk() {
+		#ifndef DISABLE_PCINT_MULTI_SERVICE
+		uint8_t pcifr;
+		while (true) {
+		#endif
+			uint8_t changedPins = (PCintPort::curr ^ lastPinView) &
+								  ((portRisingPins & PCintPort::curr ) | ( portFallingPins & ~PCintPort::curr ));
+			lastPinView = PCintPort::curr;
+
+			unsigned long timestamp = 0;
+			if (changedPins & portTimedPins) timestamp = PCINT_TIMESTAMP_FUNCTION();
+
+			PCintPin* p = firstPin;
+			while (p) {
+				if (p->mask & changedPins) {
+					#ifndef NO_PIN_STATE
+					PCintPort::pinState=PCintPort::curr & p->mask ? HIGH : LOW;
+					#endif
+					#ifndef NO_PIN_NUMBER
+					PCintPort::arduinoPin=p->arduinoPin;
+					#endif
+					if (p->PCintTimedFunc != NULL) p->PCintTimedFunc(timestamp);
+					else p->PCintFunc();
+				}
+				p=p->next;
+			}
+		#ifndef DISABLE_PCINT_MULTI_SERVICE
+			pcifr = PCIFR & PCICRbit;
+			if (pcifr == 0) break;
+			PCIFR |= PCICRbit;
+			PCintPort::curr=portInputReg;
+		}
+		#endif
+	}
+};
+
+BenchPort onePin;
+BenchPort fourPins;
+BenchPort eightPins;
+
+// Average cycles per PCint() call when the pins in changed toggle on every call.
+uint16_t measure(BenchPort& port, bool table, uint8_t changed) {
+	uint8_t oldSREG = SREG;
+	cli();
+	PCintPort::curr=0;
+	port.PCint(); // start from lastPinView == curr == 0
+	handlerCalls=0;
+	uint16_t start=TCNT1;
+	for (uint8_t i=0; i < CALLS; i++) {
+		PCintPort::curr ^= changed;
+		if (table) port.PCint();
+		else port.listWalk();
+	}
+	uint16_t cycles=TCNT1 - start;
+	SREG = oldSREG;
+
+	uint8_t expected=0;
+	for (uint8_t bits=changed; bits; bits &= bits - 1) expected++;
+	if (handlerCalls != (uint16_t)expected * CALLS) Serial.print(" (handler calls wrong!)");
+	return (cycles + CALLS / 2) / CALLS;
+}
+
+void report(const char* name, BenchPort& port, uint8_t changed) {
+	Serial.print(name);
+	Serial.print(": table ");
+	Serial.print(measure(port, true, changed));
+	Serial.print(" list ");
+	Serial.print(measure(port, false, changed));
+}
+
+void benchmark(uint8_t pins, BenchPort& port) {
+	uint8_t all=0xFF >> (8 - pins);
+	Serial.print("pins: ");
+	Serial.print(pins);
+	report("  none changed", port, 0);
+	report("  one changed", port, 1 << (pins - 1));
+	report("  all changed", port, all);
+	Serial.println();
+}
+
+void setup() {
+	Serial.begin(115200);
+	Serial.println("PCintBenchmark: cycles per PCint() call");
+
+	uint8_t oldPCICR=PCICR;
+	onePin.add(0);
+	for (uint8_t pin=0; pin < 4; pin++) fourPins.add(pin);
+	for (uint8_t pin=0; pin < 8; pin++) eightPins.add(pin);
+	PCICR=oldPCICR; // addPin() enabled port D, but only benchMask was changed
+
+	uint8_t oldTCCR1A=TCCR1A;
+	uint8_t oldTCCR1B=TCCR1B;
+	TCCR1A=0;
+	TCCR1B=_BV(CS10); // no prescaler, one count per cycle
+
+	benchmark(1, onePin);
+	benchmark(4, fourPins);
+	benchmark(8, eightPins);
+
+	TCCR1A=oldTCCR1A;
+	TCCR1B=oldTCCR1B;
+}
+
+void loop() {
+}
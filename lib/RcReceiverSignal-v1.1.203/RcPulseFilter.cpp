@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------------
+//  RcReceiverSignal Library - RcPulseFilter
+//  The code & updates for the library can be found on http://end2endzone.com
+//
+// See "RcPulseFilter.h" for license, purpose, syntax, version history, links, and more.
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+#include "RcPulseFilter.h"
+
+RcPulseFilter::RcPulseFilter()
+{
+  mMedianSize = 1;
+  mAverageShift = 0;
+  mHysteresis = 0;
+  reset();
+}
+
+RcPulseFilter::~RcPulseFilter()
+{
+}
+
+bool RcPulseFilter::setup(uint8_t iMedianSize, uint8_t iAverageShift, uint8_t iHysteresis)
+{
+  if ((iMedianSize != 1 && iMedianSize != 3 && iMedianSize != 5) || iAverageShift > RCPULSEFILTER_MAX_SHIFT)
+    return false;
+
+  mMedianSize = iMedianSize;
+  mAverageShift = iAverageShift;
+  mHysteresis = iHysteresis;
+  reset();
+
+  return true;
+}
+
+void RcPulseFilter::reset()
+{
+  mHistoryIndex = 0;
+  for(uint8_t i = 0; i < RCPULSEFILTER_MAX_MEDIAN; i++)
+    mHistory[i] = 0;
+  mAverage = 0;
+  mOutput = 0xFFFF;
+  mPrimed = false;
+}
+
+uint16_t RcPulseFilter::update(uint16_t iPwmValue)
+{
+  //no pulse yet (0xFFFF) or a glitch, must not end up in the history or the average
+  if (iPwmValue < RCPULSEFILTER_MIN_PWM || iPwmValue > RCPULSEFILTER_MAX_PWM)
+    return mOutput;
+
+  if (!mPrimed)
+  {
+    //fill all stages with the first pulse, so they start settled
+    for(uint8_t i = 0; i < RCPULSEFILTER_MAX_MEDIAN; i++)
+      mHistory[i] = iPwmValue;
+    mAverage = (uint32_t)iPwmValue << mAverageShift;
+    mOutput = iPwmValue;
+    mPrimed = true;
+    return mOutput;
+  }
+
+  uint16_t value = median(iPwmValue);
+
+  if (mAverageShift != 0)
+  {
+    //mAverage holds average * 2^shift, so no precision is lost between updates
+    mAverage -= mAverage >> mAverageShift;
+    mAverage += value;
+    value = (uint16_t)((mAverage + (1 << (mAverageShift - 1))) >> mAverageShift);
+  }
+
+  uint16_t distance = value > mOutput ? value - mOutput : mOutput - value;
+  if (distance > mHysteresis)
+    mOutput = value;
+
+  return mOutput;
+}
+
+uint16_t RcPulseFilter::getPwmValue() const
+{
+  return mOutput;
+}
+
+bool RcPulseFilter::hasPwmValue() const
+{
+  return mPrimed;
+}
+
+uint16_t RcPulseFilter::median(uint16_t iPwmValue)
+{
+  if (mMedianSize == 1)
+    return iPwmValue;
+
+  mHistory[mHistoryIndex] = iPwmValue;
+  mHistoryIndex++;
+  if (mHistoryIndex >= mMedianSize)
+    mHistoryIndex = 0;
+
+  uint16_t a = mHistory[0];
+  uint16_t b = mHistory[1];
+  uint16_t c = mHistory[2];
+  if (mMedianSize == 3)
+  {
+    //max(min(a, b), min(max(a, b), c))
+    if (a > b) { uint16_t t = a; a = b; b = t; }
+    if (b > c) b = c;
+    return a > b ? a : b;
+  }
+
+  //median of 5 in 6 comparisons
+  uint16_t d = mHistory[3];
+  uint16_t e = mHistory[4];
+  uint16_t t;
+  if (a > b) { t = a; a = b; b = t; }
+  if (c > d) { t = c; c = d; d = t; }
+  //the smaller of a and c is below 3 other values, replace it with e
+  if (a < c)
+  {
+    a = e;
+    if (a > b) { t = a; a = b; b = t; }
+  }
+  else
+  {
+    c = e;
+    if (c > d) { t = c; c = d; d = t; }
+  }
+  //the median is the second smallest of the two sorted pairs
+  if (a < c)
+    return b < c ? b : c;
+  return d < a ? d : a;
+}
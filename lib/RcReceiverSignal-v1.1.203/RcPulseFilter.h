@@ -0,0 +1,136 @@
+//
+//  RcReceiverSignal Library - RcPulseFilter
+//  The code & updates for the library can be found on http://end2endzone.com
+//
+// AUTHOR/LICENSE:
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 3.0 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License (LGPL-3.0) for more details.
+//
+// DISCLAIMER:
+//  This software is furnished "as is", without technical support, and with no
+//  warranty, express or implied, as to its usefulness for any purpose.
+//
+// PURPOSE:
+//  RcPulseFilter removes the jitter from the PWM values of one receiver
+//  channel. It is meant to run in the main loop on the latest raw pulse of
+//  each frame, never in an ISR. Three integer stages can be combined, in
+//  this order:
+//
+//  median:      median of the last 3 or 5 pulses, removes single glitches.
+//               Delays a step of the stick by 1 (or 2) frames.
+//  average:     exponential moving average with a weight of 1 / 2^shift,
+//               smooths the remaining noise.
+//  hysteresis:  the output only follows when the input moves more than the
+//               hysteresis away from it, a stick at rest gives a constant value.
+//
+//  Pulses outside RCPULSEFILTER_MIN_PWM to RCPULSEFILTER_MAX_PWM never reach
+//  the stages: the 0xFFFF of a channel that has not seen a pulse yet, or a
+//  glitch far beyond any receiver's range. The filter starts with the first
+//  valid pulse, until then update() returns 0xFFFF.
+//
+//  update() uses only 16 bit compares and a 32 bit add and shift, no
+//  multiplication or division. The PulseFilter example prints the cycles
+//  it takes for each combination of stages on the target,
+//  test/pulsefilter_test.cpp runs jitter traces through it on the host.
+//
+// USAGE:
+//  RcPulseFilter steering_filter;
+//  In the setup() function:
+//    steering_filter.setup(3, 1, 4); //median of 3, average 1/2, 4 usec hysteresis
+//  Once per frame, in the loop function:
+//    unsigned long pwmValue = steering_filter.update(receiver.getPwmValue(0));
+//
+#ifndef RCPULSEFILTER_H
+#define RCPULSEFILTER_H
+
+#include "Arduino.h"
+
+#define RCPULSEFILTER_MAX_MEDIAN 5
+#define RCPULSEFILTER_MAX_SHIFT 8
+
+//pulses outside of this range are ignored, in usec
+#ifndef RCPULSEFILTER_MIN_PWM
+#define RCPULSEFILTER_MIN_PWM 800
+#endif
+#ifndef RCPULSEFILTER_MAX_PWM
+#define RCPULSEFILTER_MAX_PWM 2200
+#endif
+
+class RcPulseFilter
+{
+public:
+  RcPulseFilter();
+  ~RcPulseFilter();
+
+  /****************************************************************************
+   * Description:
+   *   setup() configures the filter stages and resets the filter.
+   * Parameters:
+   *   iMedianSize:  Number of pulses to take the median of, 1 (off), 3 or 5.
+   *   iAverageShift: Weight of a new pulse in the moving average is
+   *                  1 / 2^iAverageShift, 0 turns the average off.
+   *   iHysteresis:  Change in usec needed before the output follows the
+   *                 input, 0 turns the hysteresis off.
+   * Returns:
+   *   false if a parameter is out of range, the filter is left unchanged.
+   *
+   ****************************************************************************/
+  bool setup(uint8_t iMedianSize, uint8_t iAverageShift, uint8_t iHysteresis);
+
+  /****************************************************************************
+   * Description:
+   *   reset() forgets all previous pulses, the next valid pulse is passed
+   *   through unfiltered.
+   *
+   ****************************************************************************/
+  void reset();
+
+  /****************************************************************************
+   * Description:
+   *   update() filters the next raw pulse of the channel. A pulse outside
+   *   RCPULSEFILTER_MIN_PWM to RCPULSEFILTER_MAX_PWM is ignored.
+   * Parameters:
+   *   iPwmValue: The raw PWM value, in usec.
+   * Returns:
+   *   The filtered PWM value, in usec, 0xFFFF before the first valid pulse.
+   *
+   ****************************************************************************/
+  uint16_t update(uint16_t iPwmValue);
+
+  /****************************************************************************
+   * Description:
+   *   getPwmValue() returns the last filtered PWM value, in usec, 0xFFFF
+   *   before the first valid pulse.
+   *
+   ****************************************************************************/
+  uint16_t getPwmValue() const;
+
+  /****************************************************************************
+   * Description:
+   *   hasPwmValue() returns true once a valid pulse was filtered.
+   *
+   ****************************************************************************/
+  bool hasPwmValue() const;
+
+private:
+  uint16_t median(uint16_t iPwmValue);
+
+  //attributes
+  uint8_t mMedianSize;
+  uint8_t mAverageShift;
+  uint8_t mHysteresis;
+  uint8_t mHistoryIndex; //next slot to overwrite in mHistory
+  uint16_t mHistory[RCPULSEFILTER_MAX_MEDIAN]; //last raw pulses
+  uint32_t mAverage; //moving average, scaled by 2^mAverageShift
+  uint16_t mOutput;
+  bool mPrimed; //false until the first valid pulse
+};
+
+#endif //RCPULSEFILTER_H
@@ -0,0 +1,106 @@
+// ---------------------------------------------------------------------------
+//  RcReceiverSignal Library - RcReceiverCapture
+//  The code & updates for the library can be found on http://end2endzone.com
+//
+// See "RcReceiverCapture.h" for license, purpose, syntax, version history, links, and more.
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+#include "RcReceiverCapture.h"
+#include <IsrProfile.h> //empty unless ISR_PROFILER is defined
+
+static RcReceiverCapture * gCaptureInstance = NULL;
+
+RcReceiverCapture::RcReceiverCapture()
+{
+  mRisingTicks = 0;
+  mPwmTicks = 0xFFFF;
+  mChanged = false;
+}
+
+RcReceiverCapture::~RcReceiverCapture()
+{
+  if (gCaptureInstance == this)
+    gCaptureInstance = NULL;
+}
+
+void RcReceiverCapture::setup()
+{
+  pinMode(RCRECEIVERCAPTURE_PIN, INPUT); digitalWrite(RCRECEIVERCAPTURE_PIN, HIGH); //use the internal pullup resistor
+
+  uint8_t pushedSREG = SREG;
+  cli();
+
+  gCaptureInstance = this;
+
+  //noise canceler on, capture the first RISING edge. The waveform mode, the
+  //compare outputs and the prescaler belong to the time base (Timer1::start()),
+  //which may be shared with ServoIn, ServoOut, PPMIn or PPMOut
+  TCCR1B |= _BV(ICNC1) | _BV(ICES1);
+  TIFR1 = _BV(ICF1);
+  TIMSK1 |= _BV(ICIE1);
+
+  SREG = pushedSREG;
+}
+
+unsigned long RcReceiverCapture::getPwmValue()
+{
+  //round to the nearest usec
+  uint16_t ticks = getPwmTicks();
+  return ticks == 0xFFFF ? 0xFFFF : (ticks + 1) >> 1;
+}
+
+uint16_t RcReceiverCapture::getPwmTicks()
+{
+  //read without blocking the capture interrupt: a torn 16 bits read can only
+  //happen if the ISR ran between the two bytes, so read until two reads agree
+  uint16_t ticksCopy;
+  mChanged = false;                     // turn off the shared changed flag
+  do
+  {
+    ticksCopy = mPwmTicks;
+  } while (ticksCopy != mPwmTicks);
+
+  return ticksCopy;
+}
+
+bool RcReceiverCapture::hasChanged()
+{
+  return mChanged;
+}
+
+void RcReceiverCapture::onCapture(uint16_t iTicks, bool iRising)
+{
+  if (iRising)
+  {
+    mRisingTicks = iTicks;
+  }
+  else
+  {
+    //pulses are a lot shorter than a counter period (32.8 ms),
+    //so the 16 bits difference is correct across overflows
+    uint16_t prevPwmTicks = mPwmTicks;
+    mPwmTicks = iTicks - mRisingTicks;
+
+    //update changed flag
+    mChanged = (mPwmTicks != prevPwmTicks);
+  }
+}
+
+#if defined(TIMER1_CAPT_vect)
+ISR(TIMER1_CAPT_vect)
+{
+  ISR_PROFILE_BEGIN((uint16_t)(TCNT1 - ICR1) >> 1);
+  uint16_t ticks = ICR1;
+  bool rising = (TCCR1B & _BV(ICES1)) != 0;
+
+  //capture the other edge next, the edge change may set ICF1 so clear it
+  TCCR1B ^= _BV(ICES1);
+  TIFR1 = _BV(ICF1);
+
+  if (gCaptureInstance != NULL)
+    gCaptureInstance->onCapture(ticks, rising);
+  ISR_PROFILE_END(Vector_Timer1Capture);
+}
+
+#endif //TIMER1_CAPT_vect
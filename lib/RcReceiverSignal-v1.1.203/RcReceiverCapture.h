@@ -0,0 +1,111 @@
+//
+//  RcReceiverSignal Library - RcReceiverCapture
+//  The code & updates for the library can be found on http://end2endzone.com
+//
+// AUTHOR/LICENSE:
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 3.0 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License (LGPL-3.0) for more details.
+//
+// DISCLAIMER:
+//  This software is furnished "as is", without technical support, and with no
+//  warranty, express or implied, as to its usefulness for any purpose.
+//
+// PURPOSE:
+//  RcReceiverCapture reads the PWM signal of a single RC receiver channel with
+//  the input capture unit of Timer1 instead of a pin change interrupt.
+//
+//  The hardware latches the counter on the signal edge itself, so the pulse
+//  length does not depend on interrupt latency and has a resolution of 0.5 us
+//  (Timer1 running at F_CPU / 8) instead of the 4 us of micros(). The capture
+//  edge is toggled between rising and falling after each edge.
+//
+//  The receiver channel must be connected to the ICP1 pin (pin 8 on an
+//  ATmega328 based board). Timer1 has to run free (normal mode) at a prescaler
+//  of 8. setup() leaves the mode, the prescaler and the compare outputs alone,
+//  so the time base can be shared with other users of it (ie: ArduinoRCLib's
+//  ServoIn, ServoOut, PPMIn and PPMOut), but not with PWM on pins 9 and 10.
+//
+// USAGE:
+//  RcReceiverCapture receiver_throttle;
+//  In the setup() function, start the time base first:
+//    rc::Timer1::init();
+//    rc::Timer1::start();
+//    receiver_throttle.setup();
+//  In the loop function, use hasChanged() and getPwmValue() like with
+//  RcReceiverSignal.
+//
+#ifndef RCRECEIVERCAPTURE_H
+#define RCRECEIVERCAPTURE_H
+
+#include "Arduino.h"
+
+#define RCRECEIVERCAPTURE_PIN 8 //ICP1 on ATmega168/328 (PB0)
+
+class RcReceiverCapture
+{
+public:
+  RcReceiverCapture();
+  ~RcReceiverCapture();
+
+  /****************************************************************************
+   * Description:
+   *   setup() configures the input capture unit of Timer1 and attaches the
+   *   instance to the capture interrupt. Timer1 must already run as a 0.5 us
+   *   time base. There can only be one instance in use at any time since
+   *   there is only one input capture pin.
+   *
+   ****************************************************************************/
+  void setup();
+
+  /****************************************************************************
+   * Description:
+   *   getPwmValue() returns the last PWM value observed on the capture pin, in
+   *   usec. Like RcReceiverSignal::getPwmValue(), the method is ISR-safe and
+   *   clears the changed flag, but it never disables interrupts.
+   *
+   ****************************************************************************/
+  unsigned long getPwmValue();
+
+  /****************************************************************************
+   * Description:
+   *   getPwmTicks() returns the last PWM value observed on the capture pin in
+   *   Timer1 ticks of 0.5 usec, the full capture resolution. Clears the
+   *   changed flag.
+   *
+   ****************************************************************************/
+  uint16_t getPwmTicks();
+
+  /****************************************************************************
+   * Description:
+   *   hasChanged() returns true when the PWM value has changed since the last
+   *   call to getPwmValue() or getPwmTicks().
+   *
+   ****************************************************************************/
+  bool hasChanged();
+
+  /****************************************************************************
+   * Description:
+   *   onCapture() updates the instance with a captured edge.
+   *   This method is called from the Timer1 capture interrupt.
+   * Parameters:
+   *   iTicks:   Timer1 counter value latched on the edge.
+   *   iRising:  true if the edge was a rising edge.
+   *
+   ****************************************************************************/
+  void onCapture(uint16_t iTicks, bool iRising);
+
+private:
+  //attributes
+  volatile uint16_t mRisingTicks; //counter value on last pin rise
+  volatile uint16_t mPwmTicks; //PWM value in 0.5 us units, expected from 2000 to 4000
+  volatile bool mChanged;
+};
+
+#endif //RCRECEIVERCAPTURE_H
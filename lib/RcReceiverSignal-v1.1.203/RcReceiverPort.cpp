@@ -0,0 +1,233 @@
+// ---------------------------------------------------------------------------
+//  RcReceiverSignal Library - RcReceiverPort
+//  The code & updates for the library can be found on http://end2endzone.com
+//
+// See "RcReceiverPort.h" for license, purpose, syntax, version history, links, and more.
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+#include "RcReceiverPort.h"
+
+RcReceiverPort::RcReceiverPort()
+{
+  mInputReg = NULL;
+  mPortMask = 0;
+  mCount = 0;
+  mLastState = 0;
+  for(uint8_t i = 0; i < RCRECEIVERPORT_MAX_CHANNELS; i++)
+  {
+    mMasks[i] = 0;
+    mRisingTime[i] = 0;
+    mPwmValue[i] = 0xFFFF;
+  }
+  mChanged = 0;
+  mWriteSequence = 0;
+  mPulseCount = 0;
+  mRetries = 0;
+  mFrameChannel = 0;
+  mFrameTimeout = RCRECEIVERPORT_FRAME_TIMEOUT;
+  mLastFallingTime = 0;
+  mFramePulses = 0;
+  mFrameCount = 0;
+  mFrameTime = 0;
+  mReadFrame = 0;
+}
+
+RcReceiverPort::~RcReceiverPort()
+{
+}
+
+bool RcReceiverPort::setup(const uint8_t * iPins, uint8_t iCount)
+{
+  if (iCount == 0 || iCount > RCRECEIVERPORT_MAX_CHANNELS)
+    return false;
+
+  //all pins must share the port, and so the pin change interrupt
+  uint8_t port = digitalPinToPort(iPins[0]);
+  for(uint8_t i = 0; i < iCount; i++)
+  {
+    if (digitalPinToPort(iPins[i]) != port || digitalPinToPCICR(iPins[i]) == NULL)
+      return false;
+  }
+
+  uint8_t pushedSREG = SREG;
+  cli();
+
+  mInputReg = portInputRegister(port);
+  mPortMask = 0;
+  mCount = iCount;
+  mFrameChannel = iCount - 1;
+  for(uint8_t i = 0; i < iCount; i++)
+  {
+    pinMode(iPins[i], INPUT); digitalWrite(iPins[i], HIGH); //use the internal pullup resistor
+    mMasks[i] = digitalPinToBitMask(iPins[i]);
+    mPortMask |= mMasks[i];
+    *digitalPinToPCMSK(iPins[i]) |= _BV(digitalPinToPCMSKbit(iPins[i]));
+  }
+  mLastState = *mInputReg;
+  *digitalPinToPCICR(iPins[0]) |= _BV(digitalPinToPCICRbit(iPins[0]));
+
+  SREG = pushedSREG;
+
+  return true;
+}
+
+uint8_t RcReceiverPort::getChannelCount() const
+{
+  return mCount;
+}
+
+unsigned long RcReceiverPort::getPwmValue(uint8_t iChannel)
+{
+  if (iChannel >= mCount)
+    return 0xFFFF;
+
+  uint8_t pushedSREG = SREG;            // save interrupt flag
+  cli();                                // disable interrupts
+  unsigned long pwmCopy = mPwmValue[iChannel]; // access the shared data
+  mChanged &= ~(1 << iChannel);         // turn off the shared changed flag
+  SREG = pushedSREG;                    // restore the interrupt flag
+
+  return pwmCopy;
+}
+
+void RcReceiverPort::getPwmValues(unsigned long * oValues)
+{
+  uint8_t pushedSREG = SREG;
+  cli();
+  for(uint8_t i = 0; i < mCount; i++)
+    oValues[i] = mPwmValue[i];
+  mChanged = 0;
+  SREG = pushedSREG;
+}
+
+void RcReceiverPort::getSnapshot(Snapshot & oSnapshot)
+{
+  uint8_t sequence;
+  for(;;)
+  {
+    sequence = mWriteSequence;
+    if ((sequence & 1) == 0)
+    {
+      //cleared before the copy, so a pulse completing meanwhile sets it again
+      mChanged = 0;
+
+      //the values may be torn, the sequence check below tells
+      for(uint8_t i = 0; i < mCount; i++)
+        oSnapshot.pwmValues[i] = mPwmValue[i];
+      oSnapshot.sequence = mPulseCount;
+      oSnapshot.frame = mFrameCount;
+      oSnapshot.frameTime = mFrameTime;
+
+      if (mWriteSequence == sequence)
+        break;
+    }
+    mRetries++;
+  }
+}
+
+uint16_t RcReceiverPort::getRetryCount() const
+{
+  return mRetries;
+}
+
+void RcReceiverPort::resetRetryCount()
+{
+  //only getSnapshot() counts, never the ISR
+  mRetries = 0;
+}
+
+void RcReceiverPort::setFrameChannel(uint8_t iChannel)
+{
+  if (iChannel < mCount)
+    mFrameChannel = iChannel;
+}
+
+void RcReceiverPort::setFrameTimeout(uint16_t iTimeout)
+{
+  uint8_t pushedSREG = SREG;
+  cli();
+  mFrameTimeout = iTimeout;
+  SREG = pushedSREG;
+}
+
+bool RcReceiverPort::hasNewFrame()
+{
+  //the low byte is read atomically, and 255 frames are never missed in a row
+  uint8_t frame = (uint8_t)mFrameCount;
+  if (frame == mReadFrame)
+    return false;
+  mReadFrame = frame;
+  return true;
+}
+
+unsigned long RcReceiverPort::getFrameTime() const
+{
+  uint8_t pushedSREG = SREG;
+  cli();
+  unsigned long frameTime = mFrameTime;
+  SREG = pushedSREG;
+
+  return frameTime;
+}
+
+bool RcReceiverPort::hasChanged(uint8_t iChannel)
+{
+  return (mChanged & (1 << iChannel)) != 0;
+}
+
+void RcReceiverPort::onPinChange()
+{
+  //one timestamp and one port snapshot for all channels
+  unsigned long time = micros();
+  uint16_t now = (uint16_t)time;
+  uint8_t state = *mInputReg;
+  uint8_t changedPins = (state ^ mLastState) & mPortMask;
+  mLastState = state;
+
+  //readers retry while this is odd, see getSnapshot()
+  mWriteSequence++;
+
+  //the frame channel did not fall, the first edge after the gap ends the frame
+  if (mFramePulses != 0 && time - mLastFallingTime >= mFrameTimeout)
+    completeFrame(mLastFallingTime);
+
+  for(uint8_t i = 0; changedPins != 0 && i < mCount; i++)
+  {
+    uint8_t mask = mMasks[i];
+    if ((changedPins & mask) == 0)
+      continue;
+    changedPins &= ~mask;
+
+    if (state & mask)
+    {
+      //this is a rising edge
+      mRisingTime[i] = now;
+    }
+    else
+    {
+      //this is a falling edge, pulses are much shorter than 65 ms so 16 bits will do
+      uint16_t pwmValue = now - mRisingTime[i];
+      mPulseCount++;
+      if (pwmValue != mPwmValue[i])
+      {
+        mPwmValue[i] = pwmValue;
+        mChanged |= (1 << i);
+      }
+
+      mLastFallingTime = time;
+      mFramePulses++;
+      if (i == mFrameChannel)
+        completeFrame(time);
+    }
+  }
+
+  mWriteSequence++;
+}
+
+void RcReceiverPort::completeFrame(unsigned long iTime)
+{
+  mFrameTime = iTime;
+  mFramePulses = 0;
+  mFrameCount++;
+}
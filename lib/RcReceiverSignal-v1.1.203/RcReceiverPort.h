@@ -0,0 +1,233 @@
+//
+//  RcReceiverSignal Library - RcReceiverPort
+//  The code & updates for the library can be found on http://end2endzone.com
+//
+// AUTHOR/LICENSE:
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 3.0 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License (LGPL-3.0) for more details.
+//
+// DISCLAIMER:
+//  This software is furnished "as is", without technical support, and with no
+//  warranty, express or implied, as to its usefulness for any purpose.
+//
+// PURPOSE:
+//  RcReceiverPort decodes the PWM signals of several RC receiver channels
+//  wired to the same AVR port in a single pin change interrupt.
+//
+//  Instead of one ISR per channel (and one time counter call per channel),
+//  the port interrupt takes a single timestamp, compares the port state
+//  against the previous one and updates every channel that changed in one
+//  loop. All channels are available as one array.
+//
+//  RcReceiverPort owns the pin change interrupt vector of its port. When the
+//  PinChangeInt library is used in the same sketch, define the matching
+//  NO_PORTx_PINCHANGES before including PinChangeInt.h.
+//
+// USAGE:
+//  Use the DECLARE_RECEIVER_PORT macro to declare an instance of RcReceiverPort
+//  together with the ISR of its port:
+//  ie: DECLARE_RECEIVER_PORT(receiver, PCINT2_vect); //pins 0 to 7 on an ATmega328
+//  In the setup() function, pass the pins of the channels:
+//  ie: const uint8_t pins[] = {2, 3, 4};
+//      receiver.setup(pins, 3);
+//  In the loop function, use getSnapshot() to read all channels at once, or
+//  hasChanged() / getPwmValue() per channel like with RcReceiverSignal.
+//
+//  getSnapshot() does not disable interrupts. The ISR increments a sequence
+//  counter before and after it updates the channels; the reader copies the
+//  channels and retries when the counter was odd or changed meanwhile.
+//
+//  Receivers send their channels one after the other, once per frame. A frame
+//  is complete on the falling edge of the frame channel (the last configured
+//  channel by default) or, when that channel is missing, on the first edge
+//  after a gap of at least the frame timeout. Use hasNewFrame() to run the
+//  control code once per frame instead of once per channel.
+//
+#ifndef RCRECEIVERPORT_H
+#define RCRECEIVERPORT_H
+
+#include "Arduino.h"
+#include <IsrProfile.h> //empty unless ISR_PROFILER is defined
+
+#define RCRECEIVERPORT_MAX_CHANNELS 8 //one per port pin
+#define RCRECEIVERPORT_FRAME_TIMEOUT 4000 //usec without edges that ends a frame
+
+class RcReceiverPort
+{
+public:
+  struct Snapshot
+  {
+    uint16_t pwmValues[RCRECEIVERPORT_MAX_CHANNELS]; //PWM value of each channel, in usec
+    uint16_t sequence; //number of pulses completed on all channels so far
+    uint16_t frame; //number of frames completed so far
+    unsigned long frameTime; //micros() at the end of the last frame
+  };
+
+  RcReceiverPort();
+  ~RcReceiverPort();
+
+  /****************************************************************************
+   * Description:
+   *   setup() configures the channel pins and enables the pin change
+   *   interrupt of their port.
+   * Parameters:
+   *   iPins:   The pins which are connected to the Rc Receiver, in channel order.
+   *   iCount:  Number of pins, at most RCRECEIVERPORT_MAX_CHANNELS.
+   * Returns:
+   *   false if there are too many pins or the pins are not all on the same
+   *   port, the instance is left unconfigured in that case.
+   *
+   ****************************************************************************/
+  bool setup(const uint8_t * iPins, uint8_t iCount);
+
+  /****************************************************************************
+   * Description:
+   *   getChannelCount() returns the number of configured channels.
+   *
+   ****************************************************************************/
+  uint8_t getChannelCount() const;
+
+  /****************************************************************************
+   * Description:
+   *   getPwmValue() returns the last PWM value observed on a channel, in usec.
+   *   Clears the changed flag of that channel.
+   * Parameters:
+   *   iChannel:  The channel index, the position of its pin in setup().
+   *
+   ****************************************************************************/
+  unsigned long getPwmValue(uint8_t iChannel);
+
+  /****************************************************************************
+   * Description:
+   *   getPwmValues() copies the last PWM value of every channel, in usec,
+   *   with interrupts disabled only once. Clears all changed flags.
+   * Parameters:
+   *   oValues:   Output array, at least getChannelCount() in size.
+   *
+   ****************************************************************************/
+  void getPwmValues(unsigned long * oValues);
+
+  /****************************************************************************
+   * Description:
+   *   getSnapshot() copies the last PWM value of every channel and the pulse
+   *   sequence number in one consistent read, without disabling interrupts.
+   *   Clears all changed flags.
+   * Parameters:
+   *   oSnapshot: Output snapshot, the first getChannelCount() values are set.
+   *
+   ****************************************************************************/
+  void getSnapshot(Snapshot & oSnapshot);
+
+  /****************************************************************************
+   * Description:
+   *   getRetryCount() returns how often getSnapshot() had to copy the
+   *   channels again because the ISR updated them during the copy.
+   *
+   ****************************************************************************/
+  uint16_t getRetryCount() const;
+
+  /****************************************************************************
+   * Description:
+   *   resetRetryCount() sets the getSnapshot() retry count back to 0.
+   *
+   ****************************************************************************/
+  void resetRetryCount();
+
+  /****************************************************************************
+   * Description:
+   *   setFrameChannel() selects the channel whose falling edge completes a
+   *   frame. setup() selects the last configured channel.
+   * Parameters:
+   *   iChannel:  The channel index.
+   *
+   ****************************************************************************/
+  void setFrameChannel(uint8_t iChannel);
+
+  /****************************************************************************
+   * Description:
+   *   setFrameTimeout() sets the gap without edges after which a frame is
+   *   complete even though the frame channel did not fall.
+   * Parameters:
+   *   iTimeout:  The gap in usec, shorter than the frame period and longer
+   *              than the gap between two channels.
+   *
+   ****************************************************************************/
+  void setFrameTimeout(uint16_t iTimeout);
+
+  /****************************************************************************
+   * Description:
+   *   hasNewFrame() returns true once for every frame completed since the
+   *   last call. Frames missed in between are reported as one.
+   *
+   ****************************************************************************/
+  bool hasNewFrame();
+
+  /****************************************************************************
+   * Description:
+   *   getFrameTime() returns micros() at the end of the last frame: the
+   *   falling edge of the frame channel, or the last falling edge before
+   *   the gap.
+   *
+   ****************************************************************************/
+  unsigned long getFrameTime() const;
+
+  /****************************************************************************
+   * Description:
+   *   hasChanged() returns true when the PWM value of a channel has changed
+   *   since it was last read.
+   * Parameters:
+   *   iChannel:  The channel index.
+   *
+   ****************************************************************************/
+  bool hasChanged(uint8_t iChannel);
+
+  /****************************************************************************
+   * Description:
+   *   onPinChange() updates all channels that changed since the last call.
+   *   This method is meant to be called from the port ISR declared by the
+   *   DECLARE_RECEIVER_PORT macro.
+   *
+   ****************************************************************************/
+  void onPinChange();
+
+private:
+  void completeFrame(unsigned long iTime);
+
+  //attributes
+  volatile uint8_t * mInputReg; //PINx register of the port
+  uint8_t mPortMask; //all channel pins
+  uint8_t mCount;
+  uint8_t mMasks[RCRECEIVERPORT_MAX_CHANNELS]; //pin of each channel
+  uint8_t mLastState; //port state on the previous interrupt
+  volatile uint16_t mRisingTime[RCRECEIVERPORT_MAX_CHANNELS]; //low 16 bits of micros() on last pin rise
+  volatile uint16_t mPwmValue[RCRECEIVERPORT_MAX_CHANNELS]; //PWM value expected from 1000 us to 2000 us
+  volatile uint8_t mChanged; //one bit per channel
+  volatile uint8_t mWriteSequence; //odd while the ISR updates the channels
+  volatile uint16_t mPulseCount; //pulses completed on all channels
+  uint16_t mRetries; //getSnapshot() retries
+  uint8_t mFrameChannel; //channel whose falling edge completes a frame
+  uint16_t mFrameTimeout; //usec without edges that ends a frame
+  volatile unsigned long mLastFallingTime; //micros() on the last falling edge of any channel
+  volatile uint8_t mFramePulses; //pulses completed since the last frame
+  volatile uint16_t mFrameCount; //frames completed
+  volatile unsigned long mFrameTime; //micros() at the end of the last frame
+  uint8_t mReadFrame; //low byte of mFrameCount seen by hasNewFrame()
+};
+
+#define DECLARE_RECEIVER_PORT(variable_name, vector) \
+RcReceiverPort variable_name; \
+ISR(vector) \
+{ \
+  ISR_PROFILE_BEGIN(ISR_PROFILE_NO_LATENCY); \
+  variable_name.onPinChange(); \
+  ISR_PROFILE_END(Vector_PinChange); \
+}
+
+#endif //RCRECEIVERPORT_H
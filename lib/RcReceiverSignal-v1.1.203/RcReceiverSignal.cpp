@@ -11,23 +11,63 @@
 
 #define CLAMP_VALUE(value_min, actual_value, value_max) (actual_value < value_min ? value_min : (actual_value > value_max ? value_max : actual_value)  )
 
+// Define all polynomial functions for all RcTxRxCombo enumations
+#define COMBO_FUNCTIONS(POLYNOMIAL) \
+  /*         a2,      a1,           a0            */ \
+  POLYNOMIAL(0.0,     0.220219436,  -331.6504702) /*LEGACY,*/ \
+  POLYNOMIAL(-8.0e-8, 0.2203,       -331.37)      /*SPEKTRUM_DX9_ORANGE_R620X,*/ \
+  POLYNOMIAL(0.0,     0.25089444,   -382.665703)  /*SPEKTRUM_DX9_SPEKTRUM_AR8000,*/ \
+  POLYNOMIAL(-3.0e-6, 0.2221,       -327.22)      /*TACTIC_TTX600_TACTIC_TR624_CH1,*/ \
+  POLYNOMIAL(-3.0e-6, 0.2135,       -318.97)      /*TACTIC_TTX600_TACTIC_TR624_CH2,*/ \
+  POLYNOMIAL(+4.0e-7, 0.1653,       -249.78)      /*CCPM_SERVO_TESTER,*/
+
+#ifdef RCRECEIVERSIGNAL_USE_FIXED_POINT
+
+// Fixed point version of the polynomial functions, evaluated with Horner's
+// method: ((a2 * pwm + a1) >> 8) * pwm + a0. a2 and a1 are scaled by 2^24,
+// a0 by 2^16. The coefficients are converted by the compiler.
+// Over the MIN_RECEIVER_PWM to MAX_RECEIVER_PWM range the intermediate
+// values stay below 2^26 and the result is within 1 unit of the double
+// calculation.
+typedef struct {
+  int32_t a2;
+  int32_t a1;
+  int32_t a0;
+} FIXED_POLYMONIAL_FUNCTION;
+
+#define FIXED_POINT(value, shift) ((int32_t)((value) * (1L << (shift)) + ((value) < 0 ? -0.5 : 0.5)))
+#define FIXED_POLYNOMIAL(a2, a1, a0) {FIXED_POINT(a2, 24), FIXED_POINT(a1, 24), FIXED_POINT(a0, 16)},
+
+static const FIXED_POLYMONIAL_FUNCTION comboFunctions[] PROGMEM = {
+  COMBO_FUNCTIONS(FIXED_POLYNOMIAL)
+};
+
+static RcReceiverSignal::VALUE evaluate(const FIXED_POLYMONIAL_FUNCTION * iPoly, unsigned long iPwmValue)
+{
+  int32_t pwmValue = (int32_t)iPwmValue;
+  int32_t value = (int32_t)pgm_read_dword(&iPoly->a2) * pwmValue + (int32_t)pgm_read_dword(&iPoly->a1);
+  value = (value >> 8) * pwmValue + (int32_t)pgm_read_dword(&iPoly->a0);
+
+  //truncate towards zero, like the cast of the double result
+  return (RcReceiverSignal::VALUE)(value < 0 ? -(-value >> 16) : value >> 16);
+}
+
+#else //RCRECEIVERSIGNAL_USE_FIXED_POINT
+
 typedef struct {
   double a2;
   double a1;
   double a0;
 } POLYMONIAL_FUNCTION;
 
-// Define all polynomial functions for all RcTxRxCombo enumations
+#define DOUBLE_POLYNOMIAL(a2, a1, a0) {a2, a1, a0},
+
 static POLYMONIAL_FUNCTION comboFunctions[] = {
-  //a2,     a1,           a0
-  {0.0,     0.220219436,  -331.6504702},  //LEGACY,
-  {-8.0e-8, 0.2203,       -331.37},       //SPEKTRUM_DX9_ORANGE_R620X,
-  {0.0,     0.25089444,   -382.665703},   //SPEKTRUM_DX9_SPEKTRUM_AR8000,
-  {-3.0e-6, 0.2221,       -327.22},       //TACTIC_TTX600_TACTIC_TR624_CH1,
-  {-3.0e-6, 0.2135,       -318.97},       //TACTIC_TTX600_TACTIC_TR624_CH2,
-  {+4.0e-7, 0.1653,       -249.78}        //CCPM_SERVO_TESTER,
+  COMBO_FUNCTIONS(DOUBLE_POLYNOMIAL)
 };
 
+#endif //RCRECEIVERSIGNAL_USE_FIXED_POINT
+
 #ifdef RCRECEIVERSIGNAL_USE_EXT_32BITS_COUNTER
 RcReceiverSignal::CounterFuncPtr RcReceiverSignal::mExtCntFunc = NULL;
 uint32_t RcReceiverSignal::mExtCntMul = 1;
@@ -114,7 +154,11 @@ RcReceiverSignal::VALUE RcReceiverSignal::getSignalValue(unsigned long iPwmValue
   //signalValue = map(pwmValue, MIN_RECEIVER_PWM, MAX_RECEIVER_PWM, MIN_RECEIVER_SIGNAL, MAX_RECEIVER_SIGNAL);
 
   //use a polynomial function of level 1 (only a0 and a1 are defined)
+#ifdef RCRECEIVERSIGNAL_USE_FIXED_POINT
+  signalValue = evaluate(&comboFunctions[LEGACY], pwmValue);
+#else
   signalValue = (RcReceiverSignal::VALUE)(0.220219436*pwmValue -331.6504702);
+#endif
 
   //make sure output value is within acceptable range
   signalValue = CLAMP_VALUE(MIN_RECEIVER_SIGNAL, (int)(signalValue) , MAX_RECEIVER_SIGNAL);
@@ -128,7 +172,11 @@ RcReceiverSignal::VALUE RcReceiverSignal::getDeviceSignalValue(RcTxRxCombo iComb
   unsigned long pwmValue = CLAMP_VALUE(MIN_RECEIVER_PWM, iPwmValue, MAX_RECEIVER_PWM);
 
   //find the polynomial function that matches the device combination
+#ifdef RCRECEIVERSIGNAL_USE_FIXED_POINT
+  const FIXED_POLYMONIAL_FUNCTION * poly = NULL;
+#else
   POLYMONIAL_FUNCTION * poly = NULL;
+#endif
   switch(iComboId)
   {
   case LEGACY:
@@ -148,7 +196,11 @@ RcReceiverSignal::VALUE RcReceiverSignal::getDeviceSignalValue(RcTxRxCombo iComb
   RcReceiverSignal::VALUE signalValue = 0;
 
   //use device's polynomial function for computing actual transmitter value
+#ifdef RCRECEIVERSIGNAL_USE_FIXED_POINT
+  signalValue = evaluate(poly, pwmValue);
+#else
   signalValue = (RcReceiverSignal::VALUE)(poly->a2*pwmValue*pwmValue + poly->a1*pwmValue + poly->a0);
+#endif
 
   //make sure output value is within acceptable range
   signalValue = CLAMP_VALUE(MIN_RECEIVER_SIGNAL, (int)(signalValue) , MAX_RECEIVER_SIGNAL);
@@ -47,6 +47,9 @@
 //  In the setup() function, you need to setup each instance by calling
 //  the receiver_aux1_handler_setup() function with the interrupt pin as argument:
 //  ie: receiver_aux1_handler_setup(RECEIVER_AUX1_IN_PIN);
+//  Use DECLARE_RECEIVER_SIGNAL_T to declare an instance of RcReceiverSignalT
+//  with a time counter fixed at compile time instead:
+//  ie: DECLARE_RECEIVER_SIGNAL_T(receiver_aux1_handler, micros, 1, 1);
 //  In the loop function, one can call the hasChanged() method to know if the
 //  PWM value has changed since the last call or the getPwmValue() function
 //  to get the last PWM value observed by the RcReceiverSignal instance.
@@ -57,12 +60,17 @@
 // 03/28/2016 v1.0 - Initial release.
 // 05/29/2016 v1.1 - Removed hardcoded dependencies to PinChangeInt.h and
 //                   eRCaGuy_Timer2_Counter.h libraries.
+// 10/17/2026        Fixed point signal value calculation, see
+//                   RCRECEIVERSIGNAL_USE_FIXED_POINT. test/signalvalue_test.cpp
+//                   checks it against the floating point path on the host.
+// 10/17/2026        Added RcReceiverSignalT and DECLARE_RECEIVER_SIGNAL_T.
 //
 #ifndef RCRECEIVERSIGNAL_H
 #define RCRECEIVERSIGNAL_H
 
 #define RCRECEIVERSIGNAL_USE_INT_CHANGE_EVENT
 #define RCRECEIVERSIGNAL_USE_EXT_32BITS_COUNTER
+#define RCRECEIVERSIGNAL_USE_FIXED_POINT //signal values in 32 bits integer math instead of double
 
 #include "Arduino.h"
 
@@ -96,7 +104,7 @@ public:
   typedef int8_t (*PCIntAttachInterruptFuncPtr)(uint8_t, ISR, int16_t);
   static void setAttachInterruptFunction(PCIntAttachInterruptFuncPtr iAttachInterruptPtr);
   static void setPinStatePointer(volatile uint8_t * iPinStatePtr);
-private:
+protected:
   static PCIntAttachInterruptFuncPtr mAttachIntFuncPtr;
   static volatile uint8_t * mPinStatePtr;
 public:
@@ -223,7 +231,7 @@ public:
 #endif //RCRECEIVERSIGNAL_USE_EXT_32BITS_COUNTER
 
 
-private:
+protected:
   //attributes
 #ifdef RCRECEIVERSIGNAL_USE_EXT_32BITS_COUNTER
   static CounterFuncPtr mExtCntFunc;
@@ -243,9 +251,82 @@ private:
   volatile bool mChanged;
 };
 
+/****************************************************************************
+ * Description:
+ *   RcReceiverSignalT is a RcReceiverSignal with a compile-time time counter.
+ *   The counter function is called directly instead of through the
+ *   setExternalTimeCounter() pointer and the multiplicator / divisor are
+ *   constants, so a 1/1 scaling compiles to nothing and power of two
+ *   divisors become shifts. There is no 32 bits division left in the ISR.
+ * Parameters:
+ *   CounterFunc:     The 32 bits time counter function, ie: micros or millis.
+ *   Multiplicator:   See setExternalTimeCounter(). Defaults to 1.
+ *   Divisor:         See setExternalTimeCounter(). Defaults to 1.
+ *
+ ****************************************************************************/
+template <unsigned long (*CounterFunc)(void), uint32_t Multiplicator = 1, uint32_t Divisor = 1>
+class RcReceiverSignalT : public RcReceiverSignal
+{
+public:
 #ifdef RCRECEIVERSIGNAL_USE_INT_CHANGE_EVENT
-#define DECLARE_RECEIVER_SIGNAL(variable_name) \
-RcReceiverSignal variable_name; \
+  void onPinChanged()
+  {
+    //check if library was configured
+    //this is required to prevent the code from jumping to random locations
+    if (mAttachIntFuncPtr == NULL || mPinStatePtr == NULL)
+      return;
+
+    if(*mPinStatePtr == HIGH)
+      mRisingTime = CounterFunc(); //this is a rising edge
+    else
+      updatePwmValue(); //this is a falling edge
+  }
+#else
+  void onPinRising()
+  {
+    if (mAttachIntFuncPtr == NULL || mPinStatePtr == NULL)
+      return;
+
+    mRisingTime = CounterFunc();
+
+    //prepare interrupting on pin FALLING
+    mAttachIntFuncPtr(mReceiverPin, mFallingFunction, FALLING);
+  }
+
+  void onPinFalling()
+  {
+    if (mAttachIntFuncPtr == NULL || mPinStatePtr == NULL)
+      return;
+
+    updatePwmValue();
+
+    //prepare interrupting on pin RISING
+    mAttachIntFuncPtr(mReceiverPin, mRisingFunction, RISING);
+  }
+#endif
+
+private:
+  inline void updatePwmValue()
+  {
+    //save previous value
+    unsigned long prevPwmValue = mPwmValue;
+
+    //read elapsed time since RISING, scaling by 1 is optimized away
+    mFallingTime = CounterFunc();
+    unsigned long pwmValue = (mFallingTime - mRisingTime);
+    if (Divisor != 1)
+      pwmValue /= Divisor;
+    if (Multiplicator != 1)
+      pwmValue *= Multiplicator;
+    mPwmValue = pwmValue;
+
+    //update changed flag
+    mChanged = (pwmValue != prevPwmValue);
+  }
+};
+
+#ifdef RCRECEIVERSIGNAL_USE_INT_CHANGE_EVENT
+#define DECLARE_RECEIVER_SIGNAL_HANDLERS(variable_name) \
 void variable_name ## _pin_change() \
 { \
   variable_name.onPinChanged(); \
@@ -257,8 +338,7 @@ void variable_name ## _setup(uint8_t iReceiverPin) \
 
 #else //RCRECEIVERSIGNAL_USE_INT_CHANGE_EVENT
 
-#define DECLARE_RECEIVER_SIGNAL(variable_name) \
-RcReceiverSignal variable_name; \
+#define DECLARE_RECEIVER_SIGNAL_HANDLERS(variable_name) \
 void variable_name ## _pin_rising() \
 { \
   variable_name.onPinRising(); \
@@ -273,5 +353,16 @@ void variable_name ## _setup(uint8_t iReceiverPin) \
 }
 #endif //RCRECEIVERSIGNAL_USE_INT_CHANGE_EVENT
 
+//time counter configured at runtime, see setExternalTimeCounter()
+#define DECLARE_RECEIVER_SIGNAL(variable_name) \
+RcReceiverSignal variable_name; \
+DECLARE_RECEIVER_SIGNAL_HANDLERS(variable_name)
+
+//time counter fixed at compile time
+//ie: DECLARE_RECEIVER_SIGNAL_T(receiver_aux1_handler, micros, 1, 1);
+#define DECLARE_RECEIVER_SIGNAL_T(variable_name, ...) \
+RcReceiverSignalT<__VA_ARGS__> variable_name; \
+DECLARE_RECEIVER_SIGNAL_HANDLERS(variable_name)
+
 
 #endif //RCRECEIVERSIGNAL_H
@@ -0,0 +1,224 @@
+// ---------------------------------------------------------------------------
+//  RcReceiverSignal Library - RcReceiverStats
+//  The code & updates for the library can be found on http://end2endzone.com
+//
+// See "RcReceiverStats.h" for license, purpose, syntax, version history, links, and more.
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+#include "RcReceiverStats.h"
+
+static inline void addSaturated(uint16_t & ioCount, unsigned long iValue)
+{
+  ioCount = iValue >= (unsigned long)(0xFFFF - ioCount) ? 0xFFFF : ioCount + (uint16_t)iValue;
+}
+
+//sum and count stay consistent: both are halved before the count gets to 0x8001,
+//so the sum of 16 bit values can not overflow either
+static inline void addToMean(uint32_t & ioSum, uint16_t & ioCount, uint16_t iValue)
+{
+  if (ioCount == 0x8000)
+  {
+    ioSum >>= 1;
+    ioCount >>= 1;
+  }
+  ioSum += iValue;
+  ioCount++;
+}
+
+RcReceiverStats::RcReceiverStats()
+{
+  mCount = 0;
+  mMinValid = RCRECEIVERSTATS_MIN_VALID;
+  mMaxValid = RCRECEIVERSTATS_MAX_VALID;
+  reset();
+}
+
+RcReceiverStats::~RcReceiverStats()
+{
+}
+
+bool RcReceiverStats::setup(uint8_t iCount, uint16_t iMinValid, uint16_t iMaxValid)
+{
+  if (iCount > RCRECEIVERSTATS_MAX_CHANNELS)
+    return false;
+
+  mCount = iCount;
+  mMinValid = iMinValid;
+  mMaxValid = iMaxValid;
+  reset();
+
+  return true;
+}
+
+void RcReceiverStats::reset()
+{
+  for(uint8_t i = 0; i < RCRECEIVERSTATS_MAX_CHANNELS; i++)
+  {
+    Channel & channel = mChannels[i];
+    channel.pulses = 0;
+    channel.outOfRange = 0;
+    channel.minValue = 0xFFFF;
+    channel.maxValue = 0;
+    channel.sum = 0;
+    channel.sumCount = 0;
+    channel.lastValue = 0;
+    for(uint8_t j = 0; j < RCRECEIVERSTATS_JITTER_BUCKETS; j++)
+      channel.jitter[j] = 0;
+  }
+  mFrames = 0;
+  mMissedFrames = 0;
+  mPeriods = 0;
+  mMinPeriod = 0xFFFF;
+  mMaxPeriod = 0;
+  mPeriodSum = 0;
+  mLastFrame = 0;
+  mLastFrameTime = 0;
+}
+
+void RcReceiverStats::updateFrame(uint16_t iFrame, unsigned long iFrameTime)
+{
+  if (mFrames != 0)
+  {
+    uint16_t frames = iFrame - mLastFrame;
+    unsigned long period = iFrameTime - mLastFrameTime;
+    if (frames != 1)
+    {
+      //frames completed before the main loop got to them
+      addSaturated(mMissedFrames, frames - 1);
+    }
+    else if (mMinPeriod != 0xFFFF && period >= mMinPeriod + (mMinPeriod >> 1))
+    {
+      //the receiver skipped frames, rare so the division does not hurt
+      addSaturated(mMissedFrames, (period + (mMinPeriod >> 1)) / mMinPeriod - 1);
+    }
+    else if (period < 0xFFFF)
+    {
+      if (period < mMinPeriod)
+        mMinPeriod = (uint16_t)period;
+      if (period > mMaxPeriod)
+        mMaxPeriod = (uint16_t)period;
+      addToMean(mPeriodSum, mPeriods, (uint16_t)period);
+    }
+  }
+
+  //saturates, so it never gets back to 0 and makes the next frame look like the first one
+  addSaturated(mFrames, 1);
+  mLastFrame = iFrame;
+  mLastFrameTime = iFrameTime;
+}
+
+void RcReceiverStats::updateChannel(uint8_t iChannel, uint16_t iPwmValue)
+{
+  if (iChannel >= mCount)
+    return;
+
+  Channel & channel = mChannels[iChannel];
+  if (iPwmValue < mMinValid || iPwmValue > mMaxValid)
+  {
+    addSaturated(channel.outOfRange, 1);
+    return;
+  }
+
+  addSaturated(channel.pulses, 1);
+  addToMean(channel.sum, channel.sumCount, iPwmValue);
+  if (iPwmValue < channel.minValue)
+    channel.minValue = iPwmValue;
+  if (iPwmValue > channel.maxValue)
+    channel.maxValue = iPwmValue;
+
+  if (channel.lastValue != 0)
+  {
+    uint16_t change = iPwmValue > channel.lastValue ? iPwmValue - channel.lastValue : channel.lastValue - iPwmValue;
+
+    //bucket = number of significant bits of the change
+    uint8_t bucket = 0;
+    while (change != 0 && bucket < RCRECEIVERSTATS_JITTER_BUCKETS - 1)
+    {
+      change >>= 1;
+      bucket++;
+    }
+    if (channel.jitter[bucket] != 0xFFFF)
+      channel.jitter[bucket]++;
+  }
+  channel.lastValue = iPwmValue;
+}
+
+const RcReceiverStats::Channel & RcReceiverStats::getChannel(uint8_t iChannel) const
+{
+  return mChannels[iChannel];
+}
+
+uint16_t RcReceiverStats::getMeanPwmValue(uint8_t iChannel) const
+{
+  const Channel & channel = mChannels[iChannel];
+  if (channel.sumCount == 0)
+    return 0;
+  return (uint16_t)(channel.sum / channel.sumCount);
+}
+
+uint16_t RcReceiverStats::getFrameCount() const
+{
+  return mFrames;
+}
+
+uint16_t RcReceiverStats::getMissedFrames() const
+{
+  return mMissedFrames;
+}
+
+uint16_t RcReceiverStats::getMinPeriod() const
+{
+  return mPeriods == 0 ? 0 : mMinPeriod;
+}
+
+uint16_t RcReceiverStats::getMaxPeriod() const
+{
+  return mMaxPeriod;
+}
+
+uint16_t RcReceiverStats::getMeanPeriod() const
+{
+  if (mPeriods == 0)
+    return 0;
+  return (uint16_t)(mPeriodSum / mPeriods);
+}
+
+void RcReceiverStats::print(Print & oOutput) const
+{
+  oOutput.print("frames=");
+  oOutput.print(mFrames);
+  oOutput.print(" missed=");
+  oOutput.print(mMissedFrames);
+  oOutput.print(" period=");
+  oOutput.print(getMinPeriod());
+  oOutput.print('/');
+  oOutput.print(getMeanPeriod());
+  oOutput.print('/');
+  oOutput.println(getMaxPeriod());
+
+  for(uint8_t i = 0; i < mCount; i++)
+  {
+    const Channel & channel = mChannels[i];
+    oOutput.print("ch");
+    oOutput.print(i);
+    oOutput.print(" pulses=");
+    oOutput.print(channel.pulses);
+    oOutput.print(" out=");
+    oOutput.print(channel.outOfRange);
+    oOutput.print(" pwm=");
+    oOutput.print(channel.pulses == 0 ? 0 : channel.minValue);
+    oOutput.print('/');
+    oOutput.print(getMeanPwmValue(i));
+    oOutput.print('/');
+    oOutput.print(channel.maxValue);
+    oOutput.print(" jitter=");
+    for(uint8_t j = 0; j < RCRECEIVERSTATS_JITTER_BUCKETS; j++)
+    {
+      if (j != 0)
+        oOutput.print(' ');
+      oOutput.print(channel.jitter[j]);
+    }
+    oOutput.println();
+  }
+}
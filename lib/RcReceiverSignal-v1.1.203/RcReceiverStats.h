@@ -0,0 +1,190 @@
+//
+//  RcReceiverSignal Library - RcReceiverStats
+//  The code & updates for the library can be found on http://end2endzone.com
+//
+// AUTHOR/LICENSE:
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 3.0 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License (LGPL-3.0) for more details.
+//
+// DISCLAIMER:
+//  This software is furnished "as is", without technical support, and with no
+//  warranty, express or implied, as to its usefulness for any purpose.
+//
+// PURPOSE:
+//  RcReceiverStats collects statistics about the signal quality of a
+//  receiver, to tune deadband and filter settings from real data.
+//
+//  Per channel: number of pulses, pulses out of the valid range, min, max
+//  and mean pulse width and a histogram of the change between two
+//  consecutive pulses (the jitter). Bucket i counts changes from 2^(i-1) to
+//  2^i - 1 usec, bucket 0 counts pulses that did not change at all and the
+//  last bucket all larger changes.
+//
+//  Per frame: number of frames, missed frames and min, max and mean frame
+//  period. A frame is missed when the receiver skipped it (the period is
+//  1.5 times the shortest period or more) or when the main loop did not
+//  get to it before the next one completed.
+//
+//  The updates run in the main loop, once per frame, and take only
+//  additions and compares. Divisions are done when the statistics are read.
+//
+//  Counts stop at 0xFFFF instead of wrapping around. The means are kept as a
+//  sum and a count of their own: once that count reaches 0x8000 both are
+//  halved, so the mean stays right and the older values weigh less.
+//
+// USAGE:
+//  RcReceiverStats stats;
+//  In the setup() function:
+//    stats.setup(2);
+//  For every frame, in the loop function:
+//    RcReceiverPort::Snapshot snapshot;
+//    receiver.getSnapshot(snapshot);
+//    stats.updateFrame(snapshot.frame, snapshot.frameTime);
+//    stats.updateChannel(0, snapshot.pwmValues[0]);
+//    stats.updateChannel(1, snapshot.pwmValues[1]);
+//  On demand:
+//    stats.print(Serial);
+//
+#ifndef RCRECEIVERSTATS_H
+#define RCRECEIVERSTATS_H
+
+#include "Arduino.h"
+
+#ifndef RCRECEIVERSTATS_MAX_CHANNELS
+#define RCRECEIVERSTATS_MAX_CHANNELS 4
+#endif
+#define RCRECEIVERSTATS_JITTER_BUCKETS 8
+#define RCRECEIVERSTATS_MIN_VALID 900 //usec
+#define RCRECEIVERSTATS_MAX_VALID 2100 //usec
+
+class RcReceiverStats
+{
+public:
+  struct Channel
+  {
+    uint16_t pulses; //valid pulses, stops at 0xFFFF
+    uint16_t outOfRange; //pulses outside of the valid range, stops at 0xFFFF
+    uint16_t minValue; //shortest valid pulse, in usec
+    uint16_t maxValue; //longest valid pulse, in usec
+    uint32_t sum; //of the valid pulses in sumCount, for the mean
+    uint16_t sumCount; //pulses in sum, halved with sum at 0x8000
+    uint16_t lastValue; //previous valid pulse, 0 before the first one
+    uint16_t jitter[RCRECEIVERSTATS_JITTER_BUCKETS]; //change between two valid pulses
+  };
+
+  RcReceiverStats();
+  ~RcReceiverStats();
+
+  /****************************************************************************
+   * Description:
+   *   setup() sets the number of channels and the valid pulse range, and
+   *   resets all statistics.
+   * Parameters:
+   *   iCount:     Number of channels, at most RCRECEIVERSTATS_MAX_CHANNELS.
+   *   iMinValid:  Shortest valid pulse, in usec.
+   *   iMaxValid:  Longest valid pulse, in usec.
+   * Returns:
+   *   false if there are too many channels.
+   *
+   ****************************************************************************/
+  bool setup(uint8_t iCount, uint16_t iMinValid = RCRECEIVERSTATS_MIN_VALID, uint16_t iMaxValid = RCRECEIVERSTATS_MAX_VALID);
+
+  /****************************************************************************
+   * Description:
+   *   reset() clears all statistics.
+   *
+   ****************************************************************************/
+  void reset();
+
+  /****************************************************************************
+   * Description:
+   *   updateFrame() adds a frame.
+   * Parameters:
+   *   iFrame:      The frame number, see RcReceiverPort::Snapshot.
+   *   iFrameTime:  micros() at the end of the frame.
+   *
+   ****************************************************************************/
+  void updateFrame(uint16_t iFrame, unsigned long iFrameTime);
+
+  /****************************************************************************
+   * Description:
+   *   updateChannel() adds the pulse of a channel.
+   * Parameters:
+   *   iChannel:  The channel index.
+   *   iPwmValue: The pulse width, in usec.
+   *
+   ****************************************************************************/
+  void updateChannel(uint8_t iChannel, uint16_t iPwmValue);
+
+  /****************************************************************************
+   * Description:
+   *   getChannel() returns the statistics of a channel.
+   * Parameters:
+   *   iChannel:  The channel index, less than the setup() count.
+   *
+   ****************************************************************************/
+  const Channel & getChannel(uint8_t iChannel) const;
+
+  /****************************************************************************
+   * Description:
+   *   getMeanPwmValue() returns the mean valid pulse width of a channel, in
+   *   usec, 0 when there was no valid pulse yet.
+   * Parameters:
+   *   iChannel:  The channel index.
+   *
+   ****************************************************************************/
+  uint16_t getMeanPwmValue(uint8_t iChannel) const;
+
+  /****************************************************************************
+   * Description:
+   *   getFrameCount() returns the number of frames seen, getMissedFrames()
+   *   the number of frames skipped by the receiver or the main loop.
+   *
+   ****************************************************************************/
+  uint16_t getFrameCount() const;
+  uint16_t getMissedFrames() const;
+
+  /****************************************************************************
+   * Description:
+   *   getMinPeriod(), getMaxPeriod() and getMeanPeriod() return the time
+   *   between two consecutive frames, in usec.
+   *
+   ****************************************************************************/
+  uint16_t getMinPeriod() const;
+  uint16_t getMaxPeriod() const;
+  uint16_t getMeanPeriod() const;
+
+  /****************************************************************************
+   * Description:
+   *   print() writes all statistics as text, one line for the frames and
+   *   one line per channel.
+   * Parameters:
+   *   oOutput:   Where to write to, ie: Serial.
+   *
+   ****************************************************************************/
+  void print(Print & oOutput) const;
+
+private:
+  //attributes
+  uint8_t mCount;
+  uint16_t mMinValid;
+  uint16_t mMaxValid;
+  Channel mChannels[RCRECEIVERSTATS_MAX_CHANNELS];
+  uint16_t mFrames; //stops at 0xFFFF
+  uint16_t mMissedFrames; //stops at 0xFFFF
+  uint16_t mPeriods; //number of periods in mPeriodSum, halved with it at 0x8000
+  uint16_t mMinPeriod;
+  uint16_t mMaxPeriod;
+  uint32_t mPeriodSum;
+  uint16_t mLastFrame;
+  unsigned long mLastFrameTime;
+};
+
+#endif //RCRECEIVERSTATS_H
@@ -0,0 +1,126 @@
+//
+//  RcReceiverSignal Library
+//  PulseFilter example
+//  The code & updates for the library can be found on http://end2endzone.com
+//
+// AUTHOR/LICENSE:
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 3.0 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License (LGPL-3.0) for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// DISCLAIMER:
+//  This software is furnished "as is", without technical support, and with no
+//  warranty, express or implied, as to its usefulness for any purpose.
+//
+// PURPOSE:
+//  The following example feeds a jitter trace through RcPulseFilter with
+//  several filter settings. For each setting it prints the filtered trace,
+//  how often the output changed while the stick was at rest and the number
+//  of cycles update() takes.
+//
+//  The trace is a stick at rest around 1500 usec with +/-5 usec of jitter and
+//  two glitches, followed by a step to 1800 usec. Replace it with pulses
+//  captured from your own receiver to tune the filter.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+//that's the example's library!
+#include <RcPulseFilter.h>
+
+//project's contants
+#define TRACE_LENGTH 64
+#define STEP_INDEX 40 //first pulse of the step, the stick rests before it
+#define TIMING_LOOPS 256
+
+const uint16_t trace[TRACE_LENGTH] PROGMEM = {
+  1500, 1497, 1501, 1505, 1495, 1496, 1503, 1496,
+  1500, 1504, 1495, 1441, 1496, 1501, 1501, 1496,
+  1498, 1496, 1503, 1501, 1495, 1504, 1496, 1498,
+  1505, 1505, 1504, 1558, 1498, 1495, 1503, 1497,
+  1499, 1501, 1497, 1503, 1496, 1504, 1499, 1503,
+  1805, 1797, 1796, 1804, 1804, 1805, 1798, 1800,
+  1796, 1713, 1796, 1804, 1795, 1804, 1798, 1802,
+  1805, 1803, 1801, 1800, 1802, 1804, 1802, 1800,
+};
+
+struct Setting
+{
+  uint8_t medianSize;
+  uint8_t averageShift;
+  uint8_t hysteresis;
+};
+
+const Setting settings[] = {
+  {1, 0, 0}, //unfiltered
+  {3, 0, 0},
+  {5, 0, 0},
+  {1, 2, 0},
+  {1, 0, 4},
+  {3, 1, 4},
+  {5, 2, 4},
+};
+
+RcPulseFilter filter;
+
+void runTrace(const Setting & setting)
+{
+  filter.setup(setting.medianSize, setting.averageShift, setting.hysteresis);
+
+  Serial.print("median=");
+  Serial.print(setting.medianSize);
+  Serial.print(", shift=");
+  Serial.print(setting.averageShift);
+  Serial.print(", hysteresis=");
+  Serial.println(setting.hysteresis);
+
+  uint8_t changes = 0;
+  uint16_t previous = 0;
+  for(uint8_t i = 0; i < TRACE_LENGTH; i++)
+  {
+    uint16_t value = filter.update(pgm_read_word(&trace[i]));
+    if (i > 0 && i < STEP_INDEX && value != previous)
+      changes++;
+    previous = value;
+
+    Serial.print(value);
+    Serial.print((i % 16) == 15 ? "\n" : " ");
+  }
+
+  Serial.print("changes at rest=");
+  Serial.print(changes);
+
+  //micros() has a resolution of 4 usec, so time many updates at once
+  unsigned long start = micros();
+  for(uint16_t i = 0; i < TIMING_LOOPS; i++)
+    filter.update(pgm_read_word(&trace[i % TRACE_LENGTH]));
+  unsigned long elapsed = micros() - start;
+
+  //includes reading the trace from flash and the loop itself, a few cycles
+  Serial.print(", cycles per update=");
+  Serial.println(elapsed * (F_CPU / 1000000L) / TIMING_LOOPS);
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("ready");
+
+  for(uint8_t i = 0; i < sizeof(settings) / sizeof(settings[0]); i++)
+    runTrace(settings[i]);
+}
+
+void loop() {
+}
@@ -0,0 +1,47 @@
+// ---------------------------------------------------------------------------
+//  RcReceiverSignal Library - host tests
+//  Host stand-in for the parts of Arduino.h the library uses, so the tests
+//  build with a desktop compiler. The registers are plain variables and
+//  flash is ordinary memory.
+// ---------------------------------------------------------------------------
+
+#ifndef RCRECEIVERSIGNAL_TEST_ARDUINO_H
+#define RCRECEIVERSIGNAL_TEST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+#define pgm_read_dword(address) (*(const uint32_t *)(address))
+
+static volatile uint8_t SREG = 0;
+inline void cli() {}
+inline void sei() {}
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline unsigned long micros() { return 0; }
+
+//output is discarded
+class Print
+{
+public:
+  template <class T> size_t print(T) { return 0; }
+  template <class T> size_t println(T) { return 0; }
+  size_t println() { return 0; }
+};
+
+#endif //RCRECEIVERSIGNAL_TEST_ARDUINO_H
@@ -0,0 +1,262 @@
+// ---------------------------------------------------------------------------
+//  RcReceiverSignal Library - pulse filter test
+//  The code & updates for the library can be found on http://end2endzone.com
+//
+// PURPOSE:
+//  Host test of RcPulseFilter driven by jitter traces. Every trace runs
+//  through the same filter settings as the PulseFilter example and the test
+//  checks that:
+//
+//  - nothing comes out before the first valid pulse, the 0xFFFF of a
+//    channel without a pulse and glitches out of range are ignored,
+//  - the output always stays within the valid pulse range,
+//  - a median filter removes the single pulse glitches of a stick at rest,
+//  - with a median and hysteresis the output hardly moves while the stick
+//    rests (at most twice in 40 frames, the raw pulses change 37 times),
+//  - after a step the output gets within the jitter and hysteresis of the
+//    new position in time: the median delay plus 5 * 2^shift frames for
+//    the 300 usec step of the traces.
+//
+//  It also prints how many times the output changed at rest and the host
+//  cycles per update(). The built-in traces are synthetic, a stick at rest
+//  with +/-5 usec of jitter, glitches and a step, like the PulseFilter
+//  example. To replay a recording of your own stick at rest pass a file with
+//  one pulse width per line, its statistics are printed for every setting:
+//
+//    g++ -std=gnu++11 -O2 -Ihost -I.. pulsefilter_test.cpp ../RcPulseFilter.cpp -o pulsefilter_test
+//    ./pulsefilter_test [trace.txt]
+// ---------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <vector>
+
+#include "RcPulseFilter.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLES() __rdtsc()
+#else
+#include <time.h>
+#define CYCLES() clock()
+#endif
+
+#define NO_PULSE 0xFFFF
+
+struct Setting
+{
+  uint8_t medianSize;
+  uint8_t averageShift;
+  uint8_t hysteresis;
+};
+
+static const Setting settings[] = {
+  {1, 0, 0}, //unfiltered
+  {3, 0, 0},
+  {5, 0, 0},
+  {1, 2, 0},
+  {1, 0, 4},
+  {3, 1, 4}, //main.cpp
+  {5, 2, 4},
+};
+
+struct Trace
+{
+  const char * name;
+  std::vector<uint16_t> pulses;
+  size_t restEnd; //pulses before this index are the stick at rest, after the first valid one
+  size_t step; //first pulse at the new position, or 0
+  uint16_t restValue;
+  uint16_t stepValue;
+};
+
+//the stick at rest around 1500 usec, 3 glitches, then a step to 1800 usec
+static const uint16_t jitter[] = {
+  1500, 1497, 1501, 1505, 1495, 1496, 1503, 1496,
+  1500, 1504, 1495, 1441, 1496, 1501, 1501, 1496,
+  1498, 1496, 1503, 1501, 1495, 1504, 1496, 1498,
+  1505, 1505, 1504, 1558, 1498, 1495, 1503, 1497,
+  1499, 1501, 1497, 1503, 1496, 1504, 1499, 1503,
+  1805, 1797, 1796, 1804, 1804, 1805, 1798, 1800,
+  1796, 1713, 1796, 1804, 1795, 1804, 1798, 1802,
+  1805, 1803, 1801, 1800, 1802, 1804, 1802, 1800,
+};
+#define JITTER_LENGTH (sizeof(jitter) / sizeof(jitter[0]))
+#define JITTER_STEP 40
+
+static std::vector<Trace> builtinTraces()
+{
+  std::vector<Trace> traces;
+
+  Trace rest = { "jitter", std::vector<uint16_t>(jitter, jitter + JITTER_LENGTH), JITTER_STEP, JITTER_STEP, 1500, 1800 };
+  traces.push_back(rest);
+
+  //power up: the receiver port reports 0xFFFF until the first pulse of a channel
+  Trace boot = rest;
+  boot.name = "power up";
+  boot.pulses.insert(boot.pulses.begin(), 3, NO_PULSE);
+  boot.restEnd += 3;
+  boot.step += 3;
+  traces.push_back(boot);
+
+  //dropouts and pulses far out of range while the stick rests and after the step
+  Trace dropout = rest;
+  dropout.name = "out of range";
+  dropout.pulses[5] = 0;
+  dropout.pulses[6] = 3000;
+  dropout.pulses[20] = NO_PULSE;
+  dropout.pulses[50] = 250;
+  traces.push_back(dropout);
+
+  return traces;
+}
+
+static bool isValid(uint16_t iPwmValue)
+{
+  return iPwmValue >= RCPULSEFILTER_MIN_PWM && iPwmValue <= RCPULSEFILTER_MAX_PWM;
+}
+
+static uint16_t distance(uint16_t a, uint16_t b)
+{
+  return a > b ? a - b : b - a;
+}
+
+static bool runTrace(const Trace & trace, const Setting & setting, bool check)
+{
+  RcPulseFilter filter;
+  filter.setup(setting.medianSize, setting.averageShift, setting.hysteresis);
+
+  bool ok = true;
+  int changes = 0;
+  uint16_t maxRestError = 0;
+  int settled = -1;
+  size_t first = trace.pulses.size();
+  uint16_t previous = NO_PULSE;
+  for(size_t i = 0; i < trace.pulses.size(); i++)
+  {
+    uint16_t value = filter.update(trace.pulses[i]);
+
+    if (first == trace.pulses.size() && isValid(trace.pulses[i]))
+      first = i;
+    if (i < first)
+    {
+      //nothing valid yet, nothing may come out
+      if (value != NO_PULSE || filter.hasPwmValue())
+      {
+        printf("  %s: pulse %u gives %u before the first valid pulse\n", trace.name, (unsigned)i, value);
+        ok = false;
+      }
+      continue;
+    }
+
+    if (!isValid(value))
+    {
+      printf("  %s: pulse %u gives %u, out of range\n", trace.name, (unsigned)i, value);
+      ok = false;
+    }
+
+    if (i < trace.restEnd)
+    {
+      if (i > first && value != previous)
+        changes++;
+      if (distance(value, trace.restValue) > maxRestError)
+        maxRestError = distance(value, trace.restValue);
+    }
+    else if (trace.step != 0 && settled < 0 && distance(value, trace.stepValue) <= 5 + setting.hysteresis)
+    {
+      settled = (int)(i - trace.step);
+    }
+    previous = value;
+  }
+
+  //micros() can't time this on the host, the time stamp counter can
+  const int loops = 100000;
+  filter.reset();
+  unsigned long long start = CYCLES();
+  for(int i = 0; i < loops; i++)
+    filter.update(trace.pulses[i % trace.pulses.size()]);
+  double cycles = (double)(CYCLES() - start) / loops;
+
+  printf("  median=%u shift=%u hysteresis=%u: changes at rest=%d, max rest error=%u, settled after %d, %.1f cycles per update\n",
+         setting.medianSize, setting.averageShift, setting.hysteresis, changes, maxRestError, settled, cycles);
+
+  if (check)
+  {
+    //the largest jitter of the rest phase is 5 usec, the glitches are 40 and more
+    if (setting.medianSize > 1 && maxRestError > 5)
+    {
+      printf("  %s: a glitch got through the median\n", trace.name);
+      ok = false;
+    }
+    if (setting.hysteresis >= 4 && setting.medianSize > 1 && changes > 2)
+    {
+      printf("  %s: output moved at rest\n", trace.name);
+      ok = false;
+    }
+    int settleLimit = setting.medianSize / 2 + (setting.averageShift == 0 ? 0 : 5 << setting.averageShift);
+    if (trace.step != 0 && (settled < 0 || settled > settleLimit))
+    {
+      printf("  %s: step not followed\n", trace.name);
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+static bool readTrace(const char * iPath, Trace & oTrace)
+{
+  FILE * file = fopen(iPath, "r");
+  if (file == NULL)
+    return false;
+
+  unsigned int pulse;
+  while (fscanf(file, "%u", &pulse) == 1)
+    oTrace.pulses.push_back((uint16_t)pulse);
+  fclose(file);
+
+  //a recording of the stick at rest, around the mean of its valid pulses
+  unsigned long sum = 0;
+  unsigned long count = 0;
+  for(size_t i = 0; i < oTrace.pulses.size(); i++)
+  {
+    if (isValid(oTrace.pulses[i]))
+    {
+      sum += oTrace.pulses[i];
+      count++;
+    }
+  }
+
+  oTrace.name = iPath;
+  oTrace.restEnd = oTrace.pulses.size();
+  oTrace.step = 0;
+  oTrace.restValue = count == 0 ? 0 : (uint16_t)(sum / count);
+  oTrace.stepValue = 0;
+  return count != 0;
+}
+
+int main(int argc, char ** argv)
+{
+  std::vector<Trace> traces = builtinTraces();
+  bool ok = true;
+
+  if (argc > 1)
+  {
+    Trace recorded;
+    if (!readTrace(argv[1], recorded))
+    {
+      printf("can't read %s\n", argv[1]);
+      return 1;
+    }
+    traces.push_back(recorded);
+  }
+
+  const size_t builtin = argc > 1 ? traces.size() - 1 : traces.size();
+  for(size_t t = 0; t < traces.size(); t++)
+  {
+    printf("%s, %u pulses\n", traces[t].name, (unsigned)traces[t].pulses.size());
+    for(size_t s = 0; s < sizeof(settings) / sizeof(settings[0]); s++)
+      ok = runTrace(traces[t], settings[s], t < builtin) && ok;
+  }
+
+  printf(ok ? "ok\n" : "FAILED\n");
+  return ok ? 0 : 1;
+}
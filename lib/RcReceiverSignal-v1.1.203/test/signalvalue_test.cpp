@@ -0,0 +1,105 @@
+// ---------------------------------------------------------------------------
+//  RcReceiverSignal Library - signal value test
+//  The code & updates for the library can be found on http://end2endzone.com
+//
+// PURPOSE:
+//  Host test of the fixed point polynomials (RCRECEIVERSIGNAL_USE_FIXED_POINT)
+//  against the floating point calculation they replace. For every combo and
+//  every PWM value from MIN_RECEIVER_PWM to MAX_RECEIVER_PWM (and beyond, to
+//  cover the clamping) getDeviceSignalValue() and getSignalValue() have to be
+//  within 1 unit of the same polynomial in double, and in float, which is
+//  what double is on the AVR.
+//
+//  The library source is included, so the test sees the COMBO_FUNCTIONS list
+//  the fixed point table is generated from. Build and run from this directory:
+//
+//    g++ -std=gnu++11 -O2 -Ihost signalvalue_test.cpp -o signalvalue_test
+//    ./signalvalue_test
+// ---------------------------------------------------------------------------
+
+#include <stdio.h>
+
+#include "../RcReceiverSignal.cpp"
+
+#ifndef RCRECEIVERSIGNAL_USE_FIXED_POINT
+#error "the test compares the fixed point calculation, define RCRECEIVERSIGNAL_USE_FIXED_POINT"
+#endif
+
+typedef struct {
+  double a2;
+  double a1;
+  double a0;
+} REFERENCE_FUNCTION;
+
+#define REFERENCE_POLYNOMIAL(a2, a1, a0) {a2, a1, a0},
+
+static const REFERENCE_FUNCTION referenceFunctions[] = {
+  COMBO_FUNCTIONS(REFERENCE_POLYNOMIAL)
+};
+
+static const char * const comboNames[] = {
+  "LEGACY",
+  "SPEKTRUM_DX9_ORANGE_R620X",
+  "SPEKTRUM_DX9_SPEKTRUM_AR8000",
+  "TACTIC_TTX600_TACTIC_TR624_CH1",
+  "TACTIC_TTX600_TACTIC_TR624_CH2",
+  "CCPM_SERVO_TESTER",
+};
+
+//the calculation of the floating point path, T is double on the host and float on the AVR
+template <typename T>
+static int reference(const REFERENCE_FUNCTION & iPoly, unsigned long iPwmValue)
+{
+  unsigned long pwmValue = CLAMP_VALUE(MIN_RECEIVER_PWM, iPwmValue, MAX_RECEIVER_PWM);
+  RcReceiverSignal::VALUE signalValue = (RcReceiverSignal::VALUE)((T)iPoly.a2*pwmValue*pwmValue + (T)iPoly.a1*pwmValue + (T)iPoly.a0);
+  return CLAMP_VALUE(MIN_RECEIVER_SIGNAL, (int)(signalValue), MAX_RECEIVER_SIGNAL);
+}
+
+static int difference(int a, int b)
+{
+  return a > b ? a - b : b - a;
+}
+
+int main()
+{
+  RcReceiverSignal receiver;
+  bool ok = true;
+
+  const int comboCount = sizeof(referenceFunctions) / sizeof(referenceFunctions[0]);
+  for(int combo = 0; combo < comboCount; combo++)
+  {
+    int maxDouble = 0;
+    int maxFloat = 0;
+    for(unsigned long pwm = MIN_RECEIVER_PWM - 100; pwm <= MAX_RECEIVER_PWM + 100; pwm++)
+    {
+      int actual = receiver.getDeviceSignalValue((RcTxRxCombo)combo, pwm);
+      int errorDouble = difference(actual, reference<double>(referenceFunctions[combo], pwm));
+      int errorFloat = difference(actual, reference<float>(referenceFunctions[combo], pwm));
+      if (errorDouble > maxDouble)
+        maxDouble = errorDouble;
+      if (errorFloat > maxFloat)
+        maxFloat = errorFloat;
+
+      if (errorDouble > 1 || errorFloat > 1)
+      {
+        printf("%s: pwm=%lu fixed=%d double=%d float=%d\n", comboNames[combo], pwm, actual,
+               reference<double>(referenceFunctions[combo], pwm), reference<float>(referenceFunctions[combo], pwm));
+        ok = false;
+      }
+    }
+    printf("%-32s max difference: double %d, float %d\n", comboNames[combo], maxDouble, maxFloat);
+  }
+
+  //getSignalValue() uses the LEGACY polynomial
+  for(unsigned long pwm = MIN_RECEIVER_PWM - 100; pwm <= MAX_RECEIVER_PWM + 100; pwm++)
+  {
+    if (receiver.getSignalValue(pwm) != receiver.getDeviceSignalValue(LEGACY, pwm))
+    {
+      printf("getSignalValue: pwm=%lu differs from LEGACY\n", pwm);
+      ok = false;
+    }
+  }
+
+  printf(ok ? "ok\n" : "FAILED\n");
+  return ok ? 0 : 1;
+}
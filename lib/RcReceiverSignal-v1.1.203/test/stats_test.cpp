@@ -0,0 +1,86 @@
+// ---------------------------------------------------------------------------
+//  RcReceiverSignal Library - receiver statistics test
+//  The code & updates for the library can be found on http://end2endzone.com
+//
+// PURPOSE:
+//  Host test of RcReceiverStats over a long session: 200000 frames, over an
+//  hour at 50 Hz and three times the 65535 a 16 bit count holds. Pulses
+//  alternate between 1400 and 1600 usec and frames come every 20000 usec,
+//  with a receiver skip and out of range pulses now and then. The test checks
+//  that:
+//
+//  - the counts stop at 0xFFFF instead of wrapping around,
+//  - the mean pulse width stays 1500 and the mean period 20000 usec,
+//  - no frame counts as the first one again, the missed frames are exactly
+//    the skipped ones.
+//
+//    g++ -std=gnu++11 -O2 -Ihost -I.. stats_test.cpp ../RcReceiverStats.cpp -o stats_test
+//    ./stats_test
+// ---------------------------------------------------------------------------
+
+#include <stdio.h>
+
+#include "RcReceiverStats.h"
+
+#define FRAMES 200000UL
+#define PERIOD 20000UL //usec
+#define SKIP_EVERY 1000 //frames, the receiver skips one frame
+#define OUT_OF_RANGE_EVERY 100 //frames, channel 1 gets an extra 3000 usec pulse
+
+static bool check(const char * iName, unsigned long iValue, unsigned long iExpected)
+{
+  if (iValue == iExpected)
+    return true;
+  printf("%s: %lu, expected %lu\n", iName, iValue, iExpected);
+  return false;
+}
+
+int main()
+{
+  RcReceiverStats stats;
+  stats.setup(2);
+
+  unsigned long time = 0;
+  uint16_t frame = 0;
+  unsigned long skipped = 0;
+  unsigned long outOfRange = 0;
+  for(unsigned long i = 0; i < FRAMES; i++)
+  {
+    time += PERIOD;
+    frame++;
+    if (i % SKIP_EVERY == SKIP_EVERY - 1)
+    {
+      //the receiver skipped a frame, the port counts only the ones it sees
+      time += PERIOD;
+      skipped++;
+    }
+    stats.updateFrame(frame, time);
+    stats.updateChannel(0, (i & 1) ? 1600 : 1400);
+    if (i % OUT_OF_RANGE_EVERY == 0)
+    {
+      stats.updateChannel(1, 3000);
+      outOfRange++;
+    }
+    stats.updateChannel(1, (i & 1) ? 1600 : 1400);
+  }
+
+  bool ok = true;
+  ok &= check("frames", stats.getFrameCount(), 0xFFFF);
+  ok &= check("missed frames", stats.getMissedFrames(), skipped);
+  ok &= check("mean period", stats.getMeanPeriod(), PERIOD);
+  ok &= check("min period", stats.getMinPeriod(), PERIOD);
+  ok &= check("max period", stats.getMaxPeriod(), PERIOD);
+  for(uint8_t i = 0; i < 2; i++)
+  {
+    const RcReceiverStats::Channel & channel = stats.getChannel(i);
+    ok &= check("pulses", channel.pulses, 0xFFFF);
+    ok &= check("mean pwm", stats.getMeanPwmValue(i), 1500);
+    ok &= check("min pwm", channel.minValue, 1400);
+    ok &= check("max pwm", channel.maxValue, 1600);
+  }
+  ok &= check("out of range", stats.getChannel(1).outOfRange, outOfRange);
+
+  printf("%lu frames, %lu skipped, %lu out of range\n", FRAMES, skipped, outOfRange);
+  printf(ok ? "ok\n" : "FAILED\n");
+  return ok ? 0 : 1;
+}
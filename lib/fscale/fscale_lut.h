@@ -0,0 +1,156 @@
+/* fscale_lut
+ Compile-time lookup table for fscale()
+
+ fscale() needs two soft-float pow() calls per sample, which is far too slow
+ for a control loop on an AVR without FPU. FScaleTable evaluates the very same
+ curve at compile time for a fixed set of parameters, stores the result in
+ PROGMEM and interpolates linearly between the table points at runtime using
+ only 16 bit integer arithmetic.
+
+ Template parameters:
+
+ originalMin, originalMax, newBegin, newEnd, curve - same meaning as the
+          fscale() parameters, curve limited to whole numbers [-10 - 10]
+ stepShift - distance between two table points as a power of two, the table
+          holds ((originalMax - originalMin) >> stepShift) + 2 points
+
+ Usage:
+
+  typedef FScaleTable<0, 500, 0, 255, -3, 4> Slowdown; // 33 points, 66 bytes of flash
+  int value = Slowdown::lookup(stickValue);            // ~ fscale(0, 500, 0, 255, stickValue, -3)
+
+ The table values are rounded to the nearest integer, so lookup() differs at
+ most one unit from the (truncated) fscale() result as long as the curve is
+ smooth enough over a single step. Positive curve values are steep near
+ originalMin, use a smaller stepShift for those. test/fscale_benchmark.cpp
+ measures the error and speed against fscale() on the host.
+*/
+
+#ifndef FSCALE_LUT_H
+#define FSCALE_LUT_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+namespace fscale_lut
+{
+  // constexpr replacements for exp(), log() and pow(), C++11 style
+  // (single return statement) so they can be evaluated by the compiler
+
+  constexpr double LN2 = 0.69314718055994530942;
+  constexpr double LN10 = 2.30258509299404568402;
+
+  constexpr double expSeries(double x, int n, double term, double sum) {
+    return n > 16 ? sum : expSeries(x, n + 1, term * x / n, sum + term * x / n);
+  }
+
+  constexpr double square(double x) {
+    return x * x;
+  }
+
+  // exp(x) = exp(x / 2^halvings) ^ (2^halvings), keeps the series argument small
+  constexpr double exp(double x, int halvings = 8) {
+    return halvings == 0 ? expSeries(x, 1, 1.0, 1.0) : square(exp(x / 2, halvings - 1));
+  }
+
+  // sum of z^n / n for odd n, which is atanh(z)
+  constexpr double atanhSeries(double z2, double power, int n, double sum) {
+    return n > 31 ? sum : atanhSeries(z2, power * z2, n + 2, sum + power * z2 / (n + 2));
+  }
+
+  // log(m) for m in [0.5 - 1], ln(m) = 2 * atanh((m - 1) / (m + 1))
+  constexpr double logMantissa(double z) {
+    return 2 * atanhSeries(z * z, z, 1, z);
+  }
+
+  constexpr double log(double x, int exponent = 0) {
+    return x < 0.5 ? log(x * 2, exponent + 1) :
+           (x > 1.0 ? log(x / 2, exponent - 1) : logMantissa((x - 1) / (x + 1)) - exponent * LN2);
+  }
+
+  constexpr double pow(double base, double exponent) {
+    return base <= 0 ? 0 : exp(exponent * log(base));
+  }
+
+  template <int... Is> struct IndexList {};
+
+  template <int N, int... Is>
+  struct MakeIndexList : MakeIndexList<N - 1, N - 1, Is...> {};
+
+  template <int... Is>
+  struct MakeIndexList<0, Is...> {
+    typedef IndexList<Is...> Type;
+  };
+
+  // holds the PROGMEM table of a curve, generated from Curve::entry(0..N-1)
+  template <class Curve, class Indices> struct Table;
+
+  template <class Curve, int... Is>
+  struct Table<Curve, IndexList<Is...> > {
+    static const int16_t values[sizeof...(Is)];
+  };
+
+  template <class Curve, int... Is>
+  const int16_t Table<Curve, IndexList<Is...> >::values[sizeof...(Is)] PROGMEM = { Curve::entry(Is)... };
+}
+
+template <long originalMin, long originalMax, long newBegin, long newEnd, int curve, uint8_t stepShift>
+class FScaleTable {
+  public:
+    static const uint16_t Step = 1u << stepShift;
+    static const uint16_t PointCount = ((originalMax - originalMin) >> stepShift) + 2;
+
+    static_assert(originalMin < originalMax, "originalMin MUST be less than originalMax");
+    static_assert(originalMin >= -32768 && originalMax <= 32767, "input range must fit in 16 bits");
+    static_assert(((newEnd > newBegin ? newEnd - newBegin : newBegin - newEnd) << stepShift) < 32768,
+                  "output range too large for 16 bit interpolation, use a smaller stepShift");
+
+    // the value fscale() yields at table point p, rounded to the nearest integer
+    static constexpr int16_t entry(int p) {
+      return roundToInt(scaled(normalized(originalMin + (static_cast<long>(p) << stepShift))));
+    }
+
+    static int16_t lookup(int16_t inputValue) {
+      if (inputValue < originalMin) {
+        inputValue = originalMin;
+      }
+      if (inputValue > originalMax) {
+        inputValue = originalMax;
+      }
+
+      const uint16_t offset = static_cast<uint16_t>(inputValue - originalMin);
+      const uint16_t index = offset >> stepShift;
+      const int16_t fraction = offset & (Step - 1);
+
+      const int16_t low = pgm_read_word(&Values::values[index]);
+      const int16_t high = pgm_read_word(&Values::values[index + 1]);
+
+      return low + (((high - low) * fraction) >> stepShift);
+    }
+
+  private:
+    typedef fscale_lut::Table<FScaleTable, typename fscale_lut::MakeIndexList<PointCount>::Type> Values;
+
+    // same conditioning of the curve parameter as fscale()
+    static constexpr double exponent() {
+      return fscale_lut::exp((curve > 10 ? 10 : (curve < -10 ? -10 : curve)) * -0.1 * fscale_lut::LN10);
+    }
+
+    // not clamped to originalMax, the last point extrapolates the curve so the
+    // final (partial) step interpolates towards the right value
+    static constexpr double normalized(long inputValue) {
+      return static_cast<double>(inputValue - originalMin) / (originalMax - originalMin);
+    }
+
+    static constexpr double scaled(double normalizedValue) {
+      return newEnd > newBegin ?
+             fscale_lut::pow(normalizedValue, exponent()) * (newEnd - newBegin) + newBegin :
+             newBegin - fscale_lut::pow(normalizedValue, exponent()) * (newBegin - newEnd);
+    }
+
+    static constexpr int16_t roundToInt(double value) {
+      return static_cast<int16_t>(value < 0 ? value - 0.5 : value + 0.5);
+    }
+};
+
+#endif
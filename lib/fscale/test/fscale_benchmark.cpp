@@ -0,0 +1,107 @@
+/* fscale_benchmark
+ Host benchmark of FScaleTable against fscale()
+
+ Compares the cycles per call (time stamp counter on x86, nanoseconds
+ elsewhere) and the largest difference between the lookup
+ table and the (truncated) fscale() result over the whole input range, for
+ the curves used by src/main.cpp and a few others. Host timings only show the
+ ratio, on the AVR fscale() is far slower still because pow() is soft-float.
+
+ Build and run from this directory:
+
+  g++ -std=gnu++11 -O2 -Ihost -I.. fscale_benchmark.cpp -o fscale_benchmark && ./fscale_benchmark
+
+ Returns non zero if a table differs more than expected from fscale(): one
+ unit where the curve is smooth over a step, more where it is steep.
+*/
+
+#include <chrono>
+#include <stdio.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// the AVR core defines round() and abs() as macros, include order as in main.cpp
+#include <Arduino.h>
+#include <fscale.h>
+#include <fscale_lut.h>
+
+namespace
+{
+  const int Repeat = 2000;
+
+  volatile int16_t sink;
+
+  double now() {
+    #if defined(__x86_64__) || defined(__i386__)
+      return static_cast<double>(__rdtsc());
+    #else
+      return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    #endif
+  }
+
+  template <class Table>
+  double lookupCycles(int16_t originalMin, int16_t originalMax) {
+    const double start = now();
+    for (int r = 0; r < Repeat; ++r) {
+      for (int16_t i = originalMin; i <= originalMax; ++i) {
+        sink = Table::lookup(i);
+      }
+    }
+    return (now() - start) / (Repeat * (originalMax - originalMin + 1.0));
+  }
+
+  double fscaleCycles(int16_t originalMin, int16_t originalMax, int16_t newBegin, int16_t newEnd, int curve) {
+    const double start = now();
+    for (int r = 0; r < Repeat; ++r) {
+      for (int16_t i = originalMin; i <= originalMax; ++i) {
+        sink = fscale(originalMin, originalMax, newBegin, newEnd, i, curve);
+      }
+    }
+    return (now() - start) / (Repeat * (originalMax - originalMin + 1.0));
+  }
+
+  template <long originalMin, long originalMax, long newBegin, long newEnd, int curve, uint8_t stepShift>
+  bool compare(int allowedError) {
+    typedef FScaleTable<originalMin, originalMax, newBegin, newEnd, curve, stepShift> Table;
+
+    int maxError = 0;
+    for (int16_t i = originalMin; i <= originalMax; ++i) {
+      const int expected = fscale(originalMin, originalMax, newBegin, newEnd, i, curve);
+      const int actual = Table::lookup(i);
+      const int error = actual > expected ? actual - expected : expected - actual;
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+
+    const double tableCycles = lookupCycles<Table>(originalMin, originalMax);
+    const double fscaleCycles = ::fscaleCycles(originalMin, originalMax, newBegin, newEnd, curve);
+    printf("%4ld..%-4ld -> %4ld..%-4ld curve %3d step %2u  %3u points  max error %d  fscale %6.1f  table %5.1f cycles  %5.1fx\n",
+           originalMin, originalMax, newBegin, newEnd, curve, static_cast<unsigned>(Table::Step),
+           static_cast<unsigned>(Table::PointCount), maxError, fscaleCycles, tableCycles, fscaleCycles / tableCycles);
+    return maxError <= allowedError;
+  }
+}
+
+int main() {
+  bool ok = true;
+
+  // the curves of src/main.cpp
+  ok &= compare<0, 500, 0, 256, 0, 4>(1);
+  ok &= compare<0, 500, 0, 256, -3, 4>(1);
+
+  // finer tables, an inverted and a signed range
+  ok &= compare<0, 500, 0, 256, -3, 2>(1);
+  ok &= compare<0, 500, 255, 0, -3, 4>(1);
+  ok &= compare<-500, 500, 0, 1000, -5, 3>(1);
+
+  // steep curves need a smaller step, positive ones near originalMin
+  ok &= compare<0, 500, 0, 256, -10, 4>(3);
+  ok &= compare<0, 500, 0, 256, -10, 2>(1);
+  ok &= compare<0, 500, 0, 256, 3, 2>(6);
+  ok &= compare<0, 500, 0, 256, 3, 0>(1);
+
+  puts(ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,20 @@
+/* Host stand-in for the parts of Arduino.h used by fscale, so the benchmark
+ builds with a desktop compiler. The macros mirror the AVR core, which
+ defines them after including math.h. */
+
+#ifndef FSCALE_TEST_ARDUINO_H
+#define FSCALE_TEST_ARDUINO_H
+
+#include <stdint.h>
+#include <math.h>
+#include <avr/pgmspace.h>
+
+typedef bool boolean;
+
+#ifdef abs
+#undef abs
+#endif
+#define abs(x) ((x)>0?(x):-(x))
+#define round(x) ((x)>=0?(long)((x)+0.5):(long)((x)-0.5))
+
+#endif
@@ -0,0 +1,11 @@
+/* Host stand-in for avr/pgmspace.h, flash is ordinary memory on the host. */
+
+#ifndef FSCALE_TEST_PGMSPACE_H
+#define FSCALE_TEST_PGMSPACE_H
+
+#include <stdint.h>
+
+#define PROGMEM
+#define pgm_read_word(address) (*(const uint16_t*)(address))
+
+#endif
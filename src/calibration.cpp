@@ -0,0 +1,143 @@
+#include <Arduino.h>
+#include <stddef.h>
+#include <string.h>
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include "calibration.h"
+
+#define CALIBRATION_VERSION 1
+
+uint16_t Calibration::stickRange = 500;
+Calibration::Channel Calibration::channels[CALIBRATION_CHANNELS];
+uint16_t Calibration::scaleLow[CALIBRATION_CHANNELS];
+uint16_t Calibration::scaleHigh[CALIBRATION_CHANNELS];
+bool Calibration::calibrating = false;
+Calibration::Channel Calibration::learned[CALIBRATION_CHANNELS];
+uint32_t Calibration::centerSum[CALIBRATION_CHANNELS];
+uint8_t Calibration::centerCount[CALIBRATION_CHANNELS];
+
+void Calibration::begin(uint16_t range) {
+  stickRange = range;
+  calibrating = false;
+
+  Stored stored;
+  eeprom_read_block(&stored, reinterpret_cast<const void*>(CALIBRATION_EEPROM_ADDRESS), sizeof(stored));
+
+  if (stored.version == CALIBRATION_VERSION && stored.crc == crc(stored)) {
+    memcpy(channels, stored.channels, sizeof(channels));
+  } else {
+    for (uint8_t i = 0; i < CALIBRATION_CHANNELS; ++i) {
+      channels[i].min = 1000;
+      channels[i].center = 1500;
+      channels[i].max = 2000;
+    }
+  }
+
+  computeScales();
+}
+
+void Calibration::start() {
+  for (uint8_t i = 0; i < CALIBRATION_CHANNELS; ++i) {
+    learned[i].min = 0xFFFF;
+    learned[i].center = 0;
+    learned[i].max = 0;
+    centerSum[i] = 0;
+    centerCount[i] = 0;
+  }
+  calibrating = true;
+}
+
+bool Calibration::finish() {
+  if (!calibrating) {
+    return false;
+  }
+  calibrating = false;
+
+  for (uint8_t i = 0; i < CALIBRATION_CHANNELS; ++i) {
+    // uint16_t differences stay unsigned on the AVR, a stick that never went below (or above)
+    // the center would wrap around and pass, so compare without subtracting; min and max
+    // are on their side of the center before MinTravel is added, which can't overflow then
+    const Channel& channel = learned[i];
+    if (centerCount[i] < CenterSamples ||
+        channel.min > channel.center ||
+        channel.max < channel.center ||
+        channel.min + MinTravel > channel.center ||
+        channel.center + MinTravel > channel.max) {
+      return false;
+    }
+  }
+
+  memcpy(channels, learned, sizeof(channels));
+  computeScales();
+
+  Stored stored;
+  stored.version = CALIBRATION_VERSION;
+  memcpy(stored.channels, channels, sizeof(channels));
+  stored.crc = crc(stored);
+  // only rewrites the bytes that changed
+  eeprom_update_block(&stored, reinterpret_cast<void*>(CALIBRATION_EEPROM_ADDRESS), sizeof(stored));
+  return true;
+}
+
+bool Calibration::isCalibrating() {
+  return calibrating;
+}
+
+void Calibration::update(uint8_t channel, uint16_t pulse) {
+  // no pulse yet, or glitches far outside of any receiver's range
+  if (!calibrating || channel >= CALIBRATION_CHANNELS || pulse < 800 || pulse > 2200) {
+    return;
+  }
+
+  Channel& learning = learned[channel];
+  if (centerCount[channel] < CenterSamples) {
+    // the sticks rest in the center while the calibration starts
+    centerSum[channel] += pulse;
+    if (++centerCount[channel] == CenterSamples) {
+      learning.center = centerSum[channel] / CenterSamples;
+    }
+    return;
+  }
+
+  if (pulse < learning.min) {
+    learning.min = pulse;
+  }
+  if (pulse > learning.max) {
+    learning.max = pulse;
+  }
+}
+
+int16_t Calibration::toStick(uint8_t channel, uint16_t pulse) {
+  const int16_t offset = static_cast<int16_t>(pulse - channels[channel].center);
+  const uint16_t scale = offset < 0 ? scaleLow[channel] : scaleHigh[channel];
+
+  // Q8 scale, rounded to the nearest stick unit
+  int32_t stick = (static_cast<int32_t>(offset) * scale + 128) >> 8;
+  if (stick > 0x7FFF) {
+    stick = 0x7FFF;
+  } else if (stick < -0x7FFF) {
+    stick = -0x7FFF;
+  }
+  return static_cast<int16_t>(stick);
+}
+
+const Calibration::Channel& Calibration::getChannel(uint8_t channel) {
+  return channels[channel];
+}
+
+uint16_t Calibration::crc(const Stored& stored) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&stored);
+  uint16_t value = 0xFFFF;
+  for (uint8_t i = 0; i < offsetof(Stored, crc); ++i) {
+    value = _crc16_update(value, bytes[i]);
+  }
+  return value;
+}
+
+void Calibration::computeScales() {
+  // the only divisions, done once per calibration instead of once per pulse
+  for (uint8_t i = 0; i < CALIBRATION_CHANNELS; ++i) {
+    scaleLow[i] = (static_cast<uint32_t>(stickRange) << 8) / (channels[i].center - channels[i].min);
+    scaleHigh[i] = (static_cast<uint32_t>(stickRange) << 8) / (channels[i].max - channels[i].center);
+  }
+}
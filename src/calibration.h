@@ -0,0 +1,67 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <stdint.h>
+
+#define CALIBRATION_CHANNELS 2
+#define CALIBRATION_EEPROM_ADDRESS 0
+
+// Center and endpoints of the receiver channels, learned from the transmitter.
+//
+// Receivers center anywhere between 1490 and 1520 us and travel 1000 - 2000
+// or only 1100 - 1900 us. toStick() maps a pulse to the stick range using
+// the learned center and one precomputed Q8 scale factor per side, so it
+// costs a subtraction and a multiplication instead of a division.
+//
+// Calibrating: start() with the sticks released, the first pulses give the
+// center. Then move every stick to both ends and finish(), which stores the
+// result in EEPROM with a CRC. begin() loads it again, or falls back to
+// 1000 / 1500 / 2000 us when the EEPROM holds no valid calibration.
+class Calibration {
+  public:
+    struct Channel {
+      uint16_t min; // pulse widths in microseconds
+      uint16_t center;
+      uint16_t max;
+    };
+
+    static const uint8_t CenterSamples = 16; // pulses averaged for the center, power of two
+    static const uint16_t MinTravel = 100; // from the center to each end, in microseconds
+
+    // stickRange: toStick() result at full travel
+    static void begin(uint16_t stickRange);
+
+    // center and endpoints learning, in between update() every channel on every frame
+    static void start();
+    // returns false and keeps the previous calibration if a stick did not travel far enough
+    static bool finish();
+    static bool isCalibrating();
+    static void update(uint8_t channel, uint16_t pulse);
+
+    // pulse in microseconds to [-stickRange - stickRange], beyond that when past the learned ends
+    static int16_t toStick(uint8_t channel, uint16_t pulse);
+
+    static const Channel& getChannel(uint8_t channel);
+
+  private:
+    struct Stored {
+      uint8_t version;
+      Channel channels[CALIBRATION_CHANNELS];
+      uint16_t crc; // CRC16 of everything before it
+    };
+
+    static uint16_t crc(const Stored& stored);
+    static void computeScales();
+
+    static uint16_t stickRange;
+    static Channel channels[CALIBRATION_CHANNELS];
+    static uint16_t scaleLow[CALIBRATION_CHANNELS]; // Q8, stick units per microsecond below the center
+    static uint16_t scaleHigh[CALIBRATION_CHANNELS]; // above the center
+
+    static bool calibrating;
+    static Channel learned[CALIBRATION_CHANNELS];
+    static uint32_t centerSum[CALIBRATION_CHANNELS];
+    static uint8_t centerCount[CALIBRATION_CHANNELS];
+};
+
+#endif
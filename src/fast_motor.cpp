@@ -0,0 +1,170 @@
+#include <Arduino.h>
+#include "fast_motor.h"
+#include <Timer1Arbiter.h>
+#include "motor_pwm.h"
+
+FastMotor::FastMotor(uint8_t pwmPin, uint8_t directionPin):
+  pwmPin(pwmPin),
+  directionPin(directionPin),
+  directionPort(portOutputRegister(digitalPinToPort(directionPin))),
+  directionMask(digitalPinToBitMask(directionPin)),
+  pwmPort(portOutputRegister(digitalPinToPort(pwmPin))),
+  pwmMask(digitalPinToBitMask(pwmPin)),
+  ocr(NULL),
+  tccr(NULL),
+  comMask(0),
+  wide(false),
+  top(0),
+  duty(0),
+  backward(false)
+{
+  // same timer / pin mapping as analogWrite()
+  switch (digitalPinToTimer(pwmPin)) {
+    #if defined(TCCR0A) && defined(COM0A1)
+    case TIMER0A:
+      ocr = &OCR0A;
+      tccr = &TCCR0A;
+      comMask = _BV(COM0A1);
+      break;
+    #endif
+    #if defined(TCCR0A) && defined(COM0B1)
+    case TIMER0B:
+      ocr = &OCR0B;
+      tccr = &TCCR0A;
+      comMask = _BV(COM0B1);
+      break;
+    #endif
+    #if defined(TCCR1A) && defined(COM1A1)
+    case TIMER1A:
+      ocr = reinterpret_cast<volatile uint8_t *>(&OCR1A);
+      tccr = &TCCR1A;
+      comMask = _BV(COM1A1);
+      wide = true;
+      break;
+    #endif
+    #if defined(TCCR1A) && defined(COM1B1)
+    case TIMER1B:
+      ocr = reinterpret_cast<volatile uint8_t *>(&OCR1B);
+      tccr = &TCCR1A;
+      comMask = _BV(COM1B1);
+      wide = true;
+      break;
+    #endif
+    #if defined(TCCR2A) && defined(COM2A1)
+    case TIMER2A:
+      ocr = &OCR2A;
+      tccr = &TCCR2A;
+      comMask = _BV(COM2A1);
+      break;
+    #endif
+    #if defined(TCCR2A) && defined(COM2B1)
+    case TIMER2B:
+      ocr = &OCR2B;
+      tccr = &TCCR2A;
+      comMask = _BV(COM2B1);
+      break;
+    #endif
+    default:
+      break;
+  }
+};
+
+void FastMotor::begin() {
+  pinMode(pwmPin, OUTPUT);
+  pinMode(directionPin, OUTPUT);
+
+  if (wide) {
+    // Timer1 PWM, default or MotorPwm, can't coexist with Timer1 time base users
+    const uint8_t compare = tccr == &TCCR1A && comMask == _BV(COM1A1) ?
+                            rc::Timer1Arbiter::Resource_CompareA : rc::Timer1Arbiter::Resource_CompareB;
+    if (!rc::Timer1Arbiter::acquire(rc::Timer1Arbiter::Client_Motor, rc::Timer1Arbiter::Resource_Waveform | compare)) {
+      // fall back to on / off, the conflict is reported by the arbiter
+      ocr = NULL;
+      wide = false;
+    }
+  }
+  top = wide ? MotorPwm::getTop() : 0;
+  duty = 0;
+  backward = false;
+  apply();
+};
+
+void FastMotor::drive(int speed) {
+  if (speed > 0) {
+    driveForward(speed);
+  } else if (speed < 0) {
+    driveBackward(-speed);
+  } else {
+    stop();
+  }
+};
+
+void FastMotor::driveForward(int speed) {
+  write(false, constrain(speed, 0, 255));
+};
+
+void FastMotor::driveBackward(int speed) {
+  write(true, constrain(255 - speed, 0, 255));
+};
+
+void FastMotor::stop() {
+  write(false, 0);
+};
+
+uint8_t FastMotor::getDuty() const {
+  return duty;
+};
+
+bool FastMotor::isBackward() const {
+  return backward;
+};
+
+void FastMotor::write(bool newBackward, uint8_t newDuty) {
+  if (newBackward == backward && newDuty == duty) {
+    return;
+  }
+  backward = newBackward;
+  duty = newDuty;
+  apply();
+};
+
+void FastMotor::apply() {
+  // scale the 8 bit duty to the MotorPwm resolution, 255 stays fully on
+  uint16_t value = duty;
+  if (top != 0) {
+    value = duty == 255 ? top : (static_cast<uint32_t>(duty) * top) >> 8;
+  }
+
+  // the ports and tccr are shared with other pins, keep the read-modify-write atomic
+  uint8_t oldSREG = SREG;
+  cli();
+
+  if (backward) {
+    *directionPort |= directionMask;
+  } else {
+    *directionPort &= ~directionMask;
+  }
+
+  if (ocr == NULL) {
+    // no PWM on this pin, behave like analogWrite()
+    if (duty < 128) {
+      *pwmPort &= ~pwmMask;
+    } else {
+      *pwmPort |= pwmMask;
+    }
+  } else if (duty == 0) {
+    // fast PWM still gives a short pulse at 0, disconnect the pin instead
+    *tccr &= ~comMask;
+    *pwmPort &= ~pwmMask;
+  } else {
+    if (wide) {
+      // 16 bit register: high byte goes into the shared TEMP register first,
+      // which an ISR reading TCNT1 may have changed
+      ocr[1] = value >> 8;
+    }
+    ocr[0] = value & 0xFF;
+    *tccr |= comMask;
+  }
+
+  SREG = oldSREG;
+};
@@ -0,0 +1,51 @@
+#ifndef FAST_MOTOR_H
+#define FAST_MOTOR_H
+
+#include <stdint.h>
+
+// Drop-in replacement for Motor that writes the hardware registers directly.
+//
+// The constructor looks up the direction pin's port / mask and the PWM pin's
+// compare register once, so a speed update is a couple of register writes
+// instead of digitalWrite() + analogWrite() with their pin table lookups.
+// Writes are skipped entirely when direction and duty did not change.
+// Call begin() from setup(), after the Arduino core has set up the timers and
+// after MotorPwm::begin() if the high frequency Timer1 PWM is used.
+class FastMotor {
+  public:
+    FastMotor(uint8_t pwmPin, uint8_t directionPin);
+    void begin();
+
+    // positive values drive forward, negative values backward, 0 stops
+    void drive(int speed);
+    void driveForward(int speed);
+    void driveBackward(int speed);
+    void stop();
+
+    // last value written to the PWM pin and the direction pin state
+    uint8_t getDuty() const;
+    bool isBackward() const;
+
+  private:
+    void write(bool backward, uint8_t duty);
+    void apply();
+
+    uint8_t pwmPin;
+    uint8_t directionPin;
+
+    volatile uint8_t * directionPort;
+    uint8_t directionMask;
+    volatile uint8_t * pwmPort;
+    uint8_t pwmMask;
+
+    volatile uint8_t * ocr; // compare register (low byte), NULL if the pin has no PWM
+    volatile uint8_t * tccr; // timer control register holding the output enable bit
+    uint8_t comMask; // connects the compare unit to the pin
+    bool wide; // 16 bit timer, the high byte of ocr has to be written as well
+    uint16_t top; // Timer1 TOP while MotorPwm is active, 0 for the default 8 bit PWM
+
+    uint8_t duty;
+    bool backward;
+};
+
+#endif
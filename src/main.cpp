@@ -2,127 +2,298 @@
 #include <stdlib.h>
 #include <Arduino.h>
 
-//RcReceiverSignal library has a dependency to PinChangeInt library.
-#include <PinChangeInt.h>
-#include <RcReceiverSignal.h>
-#include "fscale.h"
-#include "motor.h"
+#include <RcReceiverPort.h>
+#include <RcReceiverCapture.h>
+#include <RcPulseFilter.h>
+#include <RcReceiverStats.h>
+#include "fscale_lut.h"
+#include <TankMixer.h>
+#include <Timer1.h>
+#include <Timer1Arbiter.h>
+#include <IsrProfiler.h>
+#include "fast_motor.h"
+#ifdef MOTOR_BENCHMARK
+#include "motor_benchmark.h"
+#endif
+#include "motor_pwm.h"
+#include "calibration.h"
+#include "scheduler.h"
+#include "telemetry.h"
+
+// Uncomment to measure the throttle channel with Timer1's input capture unit
+// (0.5 us resolution, no interrupt latency jitter) instead of a pin change
+// interrupt. The throttle channel moves to pin 8 (ICP1), motor B to pins 4 / 5
+// so it no longer needs Timer1.
+//#define RC_THROTTLE_CAPTURE
 
 #define PIN_RC_STEERING 2
+#ifdef RC_THROTTLE_CAPTURE
+#define PIN_RC_THROTTLE RCRECEIVERCAPTURE_PIN
+#else
 #define PIN_RC_THROTTLE 3
+#endif
+
+// receiver channels decoded by the port D pin change interrupt
+#define RC_CHANNEL_STEERING 0
+#define RC_CHANNEL_THROTTLE 1
+#ifdef RC_THROTTLE_CAPTURE
+#define RC_CHANNEL_COUNT 1 // throttle comes from the capture unit
+#else
+#define RC_CHANNEL_COUNT 2
+#endif
+
+// Uncomment to run both tracks at the same, inaudible PWM frequency on Timer1.
+// Motor A PWM has to be rewired from pin 6 to pin 10 (OC1B) for this.
+// Frequency trades off against resolution, see motor_pwm.h.
+//#define MOTOR_PWM_FREQUENCY 20000 // Hz (4000 / 8000 / 20000)
 
+#ifdef MOTOR_PWM_FREQUENCY
+#define MOTOR_A_PWM 10 // Timer1, together with motor B
+#else
 #define MOTOR_A_PWM 6 // supports PWM
+#endif
 #define MOTOR_A_DIRECTION 7 // does not support PWM
 
+#ifdef RC_THROTTLE_CAPTURE
+#define MOTOR_B_DIRECTION 4 // does not support PWM
+#define MOTOR_B_PWM 5 // Timer0, together with motor A
+#else
 #define MOTOR_B_DIRECTION 8 // does not support PWM
 #define MOTOR_B_PWM 9 // supports PWM
+#endif
+
+#if defined(RC_THROTTLE_CAPTURE) && defined(MOTOR_PWM_FREQUENCY)
+#error "RC_THROTTLE_CAPTURE and MOTOR_PWM_FREQUENCY both need Timer1"
+#endif
 
 #define DEBUG
-#define CENTER_STICK_PWM 1500 // RC value for a centered joystick
-#define DEADBAND 60 // deadband around the center of the joystick, where nothing should happen
+#define CONTROL_RATE_HZ 100 // motor update rate, should divide 1000 (50 / 100 / 200), at least the frame rate
+#define SIGNAL_TIMEOUT 100000 // usec without a receiver frame after which the motors stop
+#define DEADBAND 30 // deadband around the center of the joystick, where nothing should happen
+
+#define PULSE_MEDIAN 3 // median of the last 3 pulses (1 / 3 / 5)
+#define PULSE_AVERAGE_SHIFT 1 // moving average weight 1 / 2^shift, 0 is off
+#define PULSE_HYSTERESIS 4 // usec, the pulse has to move further before it is used
 
-#define MIN_PWM 0
-#define MAX_PWM 255
 #define MIN_STICK_VALUE 0
 #define MAX_STICK_VALUE 500
+#define STEERING_CURVE -3 // fscale() curve parameter for the steering response
+#define PIVOT_LIMIT 64 // throttle [0 - 256] below which the tank starts turning on the spot
+
+// stick deflection [MIN_STICK_VALUE - MAX_STICK_VALUE] to normalized [0 - 256],
+// precomputed at compile time, one point every 16 stick units
+typedef FScaleTable<MIN_STICK_VALUE, MAX_STICK_VALUE, 0, 256, 0, 4> ThrottleCurve;
+typedef FScaleTable<MIN_STICK_VALUE, MAX_STICK_VALUE, 0, 256, STEERING_CURVE, 4> SteeringCurve;
+
+FastMotor motorA(MOTOR_A_PWM, MOTOR_A_DIRECTION); // right track
+FastMotor motorB(MOTOR_B_PWM, MOTOR_B_DIRECTION); // left track
+
+rc::TankMixer mixer(rc::TankMixer::Mode_PivotBlend, PIVOT_LIMIT);
+
+// one interrupt and one timestamp for all channels, pins 2 and 3 are both on port D
+DECLARE_RECEIVER_PORT(receiver, PCINT2_vect);
+#ifdef RC_THROTTLE_CAPTURE
+RcReceiverCapture receiver_throttle;
+#endif
 
-Motor motorA(MOTOR_A_PWM, MOTOR_A_DIRECTION);
-Motor motorB(MOTOR_B_PWM, MOTOR_B_DIRECTION);
+RcPulseFilter throttleFilter;
+RcPulseFilter steeringFilter;
 
-DECLARE_RECEIVER_SIGNAL(receiver_throttle);
-DECLARE_RECEIVER_SIGNAL(receiver_steering);
+#ifdef DEBUG
+// raw receiver signal quality, printed as text when 's' is received
+RcReceiverStats receiverStats;
+#endif
 
 void setup()
 {
-  pinMode(PIN_RC_STEERING, INPUT);
-  pinMode(PIN_RC_THROTTLE, INPUT);
-  pinMode(MOTOR_A_PWM, OUTPUT);
-  pinMode(MOTOR_A_DIRECTION, OUTPUT);
-  pinMode(MOTOR_B_PWM, OUTPUT);
-  pinMode(MOTOR_B_DIRECTION, OUTPUT);
-
-  //link RcReceiverSignal to use PinChangeInt library
-  RcReceiverSignal::setAttachInterruptFunction(&PCintPort::attachInterrupt);
-  RcReceiverSignal::setPinStatePointer(&PCintPort::pinState);
-  RcReceiverSignal::setExternalTimeCounter(&micros, 1, 1);
+  #ifdef MOTOR_PWM_FREQUENCY
+    MotorPwm::begin(MOTOR_PWM_FREQUENCY);
+  #endif
+  motorA.begin();
+  motorB.begin();
 
   #ifdef DEBUG
+    // binary telemetry, see tools/decode_telemetry.py
     Serial.begin(115200);
-    Serial.println("ready");
+    receiverStats.setup(2);
+    #ifdef MOTOR_BENCHMARK
+      // Motor against FastMotor on the motor A pins, ends with the motor stopped
+      benchmarkMotors(Serial, MOTOR_A_PWM, MOTOR_A_DIRECTION);
+    #endif
   #endif
 
-  receiver_throttle_setup(PIN_RC_THROTTLE);
-  receiver_steering_setup(PIN_RC_STEERING);
-}
+  #ifdef RC_THROTTLE_CAPTURE
+    if (rc::Timer1Arbiter::acquire(rc::Timer1Arbiter::Client_Capture,
+                                   rc::Timer1Arbiter::Resource_TimeBase | rc::Timer1Arbiter::Resource_Capture)) {
+      // normal mode instead of the core's 8 bit PWM, then the 0.5 us time base
+      rc::Timer1::init();
+      rc::Timer1::start();
+      receiver_throttle.setup();
+    }
+    const uint8_t receiverPins[RC_CHANNEL_COUNT] = { PIN_RC_STEERING };
+  #else
+    const uint8_t receiverPins[RC_CHANNEL_COUNT] = { PIN_RC_STEERING, PIN_RC_THROTTLE };
+  #endif
+  receiver.setup(receiverPins, RC_CHANNEL_COUNT);
+  // learned center and endpoints from EEPROM, see Calibration
+  Calibration::begin(MAX_STICK_VALUE);
+  throttleFilter.setup(PULSE_MEDIAN, PULSE_AVERAGE_SHIFT, PULSE_HYSTERESIS);
+  steeringFilter.setup(PULSE_MEDIAN, PULSE_AVERAGE_SHIFT, PULSE_HYSTERESIS);
 
-int getStickValue(RcReceiverSignal * receiver) {
-  // since the stick is centered, its pwm value should be 1500
-  unsigned long pwmValue = receiver->getPwmValue();
-  return pwmValue - CENTER_STICK_PWM;
+  Scheduler::begin(CONTROL_RATE_HZ);
 }
 
-void driveForward(int speed, int steeringValue) {
-  const Motor * m1;
-  const Motor * m2;
-
-  // slow down the left / right motor depending on the controller's
-  // stick deflections for left / right turns
-  const int steeringSlowdown = fscale(MIN_STICK_VALUE, MAX_STICK_VALUE, MIN_PWM, MAX_PWM, abs(steeringValue), -3);
-  const int steeringSpeed = speed - steeringSlowdown;
-
-  // determine the "main" motor m1 for the forward momentum that will run at
-  // "full" speed. Auxilliary motor m2 will run slower for steering left / right
-  if (steeringValue < 0) {
-    m1 = &motorA;
-    m2 = &motorB;
-  } else {
-    m1 = &motorB;
-    m2 = &motorA;
-  }
+int getStickValue(uint8_t channel, unsigned long pwmValue) {
+  // calibrated center and endpoints, [-MAX_STICK_VALUE - MAX_STICK_VALUE] at full travel
+  return Calibration::toStick(channel, pwmValue);
+}
 
-  m1->driveForward(speed);
-  // enable active on-the-spot turning at max steering value
-  if (abs(steeringValue) < MAX_STICK_VALUE - 20) {
-    m2->driveForward(steeringSpeed);
-  } else {
-    m2->driveBackward(speed);
+template <class Curve>
+int16_t normalize(int stickValue) {
+  // what is left of the jitter after filtering, and a slightly off center stick
+  if (stickValue > -DEADBAND and stickValue < DEADBAND) {
+    return 0;
   }
+  return stickValue < 0 ? -Curve::lookup(-stickValue) : Curve::lookup(stickValue);
 }
 
 void drive() {
 
-  const int throttleValue = getStickValue(&receiver_throttle);
-  const int steeringValue = getStickValue(&receiver_steering);
+  #ifdef DEBUG
+    const unsigned long now = micros();
+  #endif
+
+  // sample all channels in one consistent read, without blocking the receiver interrupts
+  RcReceiverPort::Snapshot pulses;
+  receiver.getSnapshot(pulses);
+  #ifdef RC_THROTTLE_CAPTURE
+    const uint16_t rawThrottlePulse = receiver_throttle.getPwmValue();
+  #else
+    const uint16_t rawThrottlePulse = pulses.pwmValues[RC_CHANNEL_THROTTLE];
+  #endif
 
   #ifdef DEBUG
-    Serial.print("Throttle Value: ");
-    Serial.println(throttleValue);
-    Serial.print("Steering Value: ");
-    Serial.println(steeringValue);
+    receiverStats.updateFrame(pulses.frame, pulses.frameTime);
+    receiverStats.updateChannel(RC_CHANNEL_STEERING, pulses.pwmValues[RC_CHANNEL_STEERING]);
+    receiverStats.updateChannel(RC_CHANNEL_THROTTLE, rawThrottlePulse);
   #endif
 
-  const int speed = map(abs(throttleValue), MIN_STICK_VALUE, MAX_STICK_VALUE, MIN_PWM, MAX_PWM);
+  // once per frame, the filters remove the jitter of the latest pulses, they ignore
+  // pulses out of range and the 0xFFFF of a channel without a pulse yet
+  const unsigned long throttlePulse = throttleFilter.update(rawThrottlePulse);
+  const unsigned long steeringPulse = steeringFilter.update(pulses.pwmValues[RC_CHANNEL_STEERING]);
 
-  // the RC signal oscillates from -50 to +50
-  if (throttleValue > -DEADBAND and throttleValue < DEADBAND) {
+  if (!throttleFilter.hasPwmValue() || !steeringFilter.hasPwmValue()) {
+    // a channel has not seen a valid pulse since power up
+    motorA.stop();
+    motorB.stop();
+    return;
+  }
 
-    // stop motor
+  if (Calibration::isCalibrating()) {
+    // the sticks go to their ends, the tank should stay where it is
+    Calibration::update(RC_CHANNEL_THROTTLE, throttlePulse);
+    Calibration::update(RC_CHANNEL_STEERING, steeringPulse);
     motorA.stop();
     motorB.stop();
+    return;
+  }
 
-  } else if (throttleValue > DEADBAND) {
-      driveForward(speed, steeringValue);
+  const int throttleValue = getStickValue(RC_CHANNEL_THROTTLE, throttlePulse);
+  const int steeringValue = getStickValue(RC_CHANNEL_STEERING, steeringPulse);
 
-  } else if (throttleValue < -DEADBAND) {
-    // accelerate backward
-    motorA.driveBackward(speed);
-    motorB.driveBackward(speed);
+  // forward / backward speed for the left and right track, range [-256 - 256]
+  int16_t left;
+  int16_t right;
+  mixer.apply(normalize<ThrottleCurve>(throttleValue), normalize<SteeringCurve>(steeringValue), left, right);
+
+  motorB.drive(left);
+  motorA.drive(right);
+
+  #ifdef DEBUG
+    // queued only, sent by Telemetry::drain() while waiting for the next frame
+    TelemetryRecord record;
+    record.timestamp = now;
+    record.throttlePulse = throttlePulse;
+    record.steeringPulse = steeringPulse;
+    record.left = left;
+    record.right = right;
+    record.dutyA = motorA.getDuty();
+    record.dutyB = motorB.getDuty();
+    record.flags = (motorA.isBackward() ? TELEMETRY_FLAG_A_BACKWARD : 0) |
+                   (motorB.isBackward() ? TELEMETRY_FLAG_B_BACKWARD : 0) |
+                   (rc::Timer1Arbiter::getConflicts() != 0 ? TELEMETRY_FLAG_TIMER1_CONFLICT : 0);
+    Telemetry::push(record);
+  #endif
+}
+
+#ifdef DEBUG
+void calibrate() {
+  if (!Calibration::isCalibrating()) {
+    Calibration::start();
+    Serial.println("calibrating: sticks centered, then move them to both ends and send c again");
+    return;
+  }
+
+  Serial.println(Calibration::finish() ? "calibrated" : "calibration failed, sticks did not travel far enough");
+  for (uint8_t i = 0; i < CALIBRATION_CHANNELS; ++i) {
+    const Calibration::Channel& channel = Calibration::getChannel(i);
+    Serial.print("ch");
+    Serial.print(i);
+    Serial.print(" pwm=");
+    Serial.print(channel.min);
+    Serial.print('/');
+    Serial.print(channel.center);
+    Serial.print('/');
+    Serial.println(channel.max);
   }
 }
+#endif
 
 void loop()
 {
-  if (receiver_throttle.hasChanged() || receiver_steering.hasChanged()) {
-    drive();
+  // update the motors at a fixed rate, from the latest complete receiver frame, so the time from
+  // the end of a frame to the motors is bounded by the tick period
+  if (Scheduler::due()) {
+    if (receiver.hasNewFrame()) {
+      drive();
+    }
+    // stop the motors when the frames stop coming
+    else if (micros() - receiver.getFrameTime() > SIGNAL_TIMEOUT) {
+      motorA.stop();
+      motorB.stop();
+    }
   }
+  #ifdef DEBUG
+  else {
+    Telemetry::drain();
+
+    // 's' prints the receiver, snapshot retry and control tick statistics, 'p' the interrupt profile
+    // (ISR_PROFILER builds), 'r' resets them, 'c' starts and finishes the stick calibration,
+    // never in the middle of a telemetry frame
+    if (Serial.available() > 0 && Telemetry::isBetweenFrames()) {
+      const int command = Serial.read();
+      if (command == 's') {
+        receiverStats.print(Serial);
+        Serial.print("snapshot retries=");
+        Serial.println(receiver.getRetryCount());
+        Scheduler::print(Serial);
+      } else if (command == 'r') {
+        receiverStats.reset();
+        receiver.resetRetryCount();
+        Scheduler::resetStatistics();
+        #ifdef ISR_PROFILER
+          rc::IsrProfiler::reset();
+        #endif
+      } else if (command == 'c') {
+        calibrate();
+      }
+      #ifdef ISR_PROFILER
+      else if (command == 'p') {
+        rc::IsrProfiler::print(Serial);
+      }
+      #endif
+    }
+  }
+  #endif
 }
@@ -4,30 +4,46 @@
 
 Motor::Motor(short pwmPin, short directionPin):
   pwmPin(pwmPin),
-  directionPin(directionPin)
+  directionPin(directionPin),
+  duty(0),
+  backward(false)
   {};
 
+void Motor::drive(int speed) {
+  if (speed > 0) {
+    driveForward(speed);
+  } else if (speed < 0) {
+    driveBackward(-speed);
+  } else {
+    stop();
+  }
+};
+
 void Motor::driveForward(int speed) {
+  duty = clamp(speed, 0, 255);
+  backward = false;
   digitalWrite(directionPin, LOW);
-  analogWrite(pwmPin, clamp(speed, 0 , 255));
-
-  #ifdef DEBUG
-    Serial.println("FORWARD");
-    Serial.println(speed);
-  #endif
+  analogWrite(pwmPin, duty);
 };
 
 void Motor::driveBackward(int speed) {
+  duty = clamp(255 - speed, 0, 255);
+  backward = true;
   digitalWrite(directionPin, HIGH);
-  analogWrite(pwmPin, clamp(255 - speed, 0, 255));
-
-  #ifdef DEBUG
-    Serial.println("BACK");
-    Serial.println(255 - speed);
-  #endif
+  analogWrite(pwmPin, duty);
 };
 
 void Motor::stop() {
+  duty = 0;
+  backward = false;
   digitalWrite(directionPin, LOW);
   digitalWrite(pwmPin, LOW);
+};
+
+uint8_t Motor::getDuty() const {
+  return duty;
+};
+
+bool Motor::isBackward() const {
+  return backward;
 };
\ No newline at end of file
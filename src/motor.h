@@ -3,11 +3,19 @@
 class Motor {
   public:
     Motor(short pwmPin, short directionPin);
+    // positive values drive forward, negative values backward, 0 stops
+    void drive(int speed);
     void driveForward(int speed);
     void driveBackward(int speed);
     void stop();
 
+    // last value written to the PWM pin and the direction pin state
+    uint8_t getDuty() const;
+    bool isBackward() const;
+
   private:
     short pwmPin;
     short directionPin;
+    uint8_t duty;
+    bool backward;
 };
\ No newline at end of file
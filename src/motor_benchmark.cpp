@@ -0,0 +1,62 @@
+#include <Arduino.h>
+#include "fast_motor.h"
+#include "motor.h"
+#include "motor_benchmark.h"
+
+namespace {
+  const int Updates = 256;
+
+  template <class Driver>
+  uint16_t sweep(Driver& driver) {
+    const uint32_t start = micros();
+    for (int speed = -255; speed <= 255; speed += 2) {
+      driver.drive(speed);
+    }
+    return ((micros() - start) * clockCyclesPerMicrosecond()) / Updates;
+  }
+
+  template <class Driver>
+  uint16_t repeat(Driver& driver) {
+    const uint32_t start = micros();
+    for (int i = 0; i < Updates; ++i) {
+      driver.drive(100);
+    }
+    return ((micros() - start) * clockCyclesPerMicrosecond()) / Updates;
+  }
+
+  template <class Driver>
+  uint16_t stop(Driver& driver) {
+    const uint32_t start = micros();
+    for (int i = 0; i < Updates; ++i) {
+      driver.stop();
+    }
+    return ((micros() - start) * clockCyclesPerMicrosecond()) / Updates;
+  }
+
+  template <class Driver>
+  void measure(Print& output, const char* name, Driver& driver) {
+    const uint16_t sweepCycles = sweep(driver);
+    const uint16_t repeatCycles = repeat(driver);
+    const uint16_t stopCycles = stop(driver);
+
+    output.print(name);
+    output.print(": sweep=");
+    output.print(sweepCycles);
+    output.print(" same=");
+    output.print(repeatCycles);
+    output.print(" stop=");
+    output.print(stopCycles);
+    output.println(" cycles per update");
+  }
+}
+
+void benchmarkMotors(Print& output, uint8_t pwmPin, uint8_t directionPin) {
+  Motor motor(pwmPin, directionPin);
+  pinMode(pwmPin, OUTPUT);
+  pinMode(directionPin, OUTPUT);
+  measure(output, "Motor", motor);
+
+  FastMotor fastMotor(pwmPin, directionPin);
+  fastMotor.begin();
+  measure(output, "FastMotor", fastMotor);
+}
@@ -0,0 +1,20 @@
+#ifndef MOTOR_BENCHMARK_H
+#define MOTOR_BENCHMARK_H
+
+#include <stdint.h>
+
+class Print;
+
+// Cycles per speed update of Motor (digitalWrite() / analogWrite()) against
+// FastMotor (direct register writes), measured on the target.
+//
+// Both drivers run the same sequences on the given pins: a sweep over all
+// speeds in both directions, the same speed over and over (FastMotor skips
+// those writes) and stop(). The loop overhead is included in every number.
+// The pins get up to full duty for well under a millisecond per sequence, too
+// short for a motor to move, and are stopped afterwards.
+//
+// Called from setup() in DEBUG builds with -DMOTOR_BENCHMARK.
+void benchmarkMotors(Print& output, uint8_t pwmPin, uint8_t directionPin);
+
+#endif
@@ -0,0 +1,65 @@
+#include <Arduino.h>
+#include <Timer1Arbiter.h>
+#include "motor_pwm.h"
+
+uint16_t MotorPwm::top = 0;
+
+bool MotorPwm::begin(uint32_t frequency) {
+  // the whole timer, both compare units drive the motor pins
+  if (!rc::Timer1Arbiter::acquire(rc::Timer1Arbiter::Client_Motor, rc::Timer1Arbiter::Resource_Waveform |
+                                  rc::Timer1Arbiter::Resource_CompareA | rc::Timer1Arbiter::Resource_CompareB)) {
+    return false;
+  }
+
+  const uint16_t newTop = topFor(frequency);
+
+  uint8_t oldSREG = SREG;
+  cli();
+  // phase correct PWM, TOP = ICR1 (mode 10), no prescaler, keep the output enable bits
+  TCCR1B = 0;
+  TCNT1 = 0;
+  ICR1 = newTop;
+  TCCR1A = (TCCR1A & (_BV(COM1A1) | _BV(COM1A0) | _BV(COM1B1) | _BV(COM1B0))) | _BV(WGM11);
+  TCCR1B = _BV(WGM13) | _BV(CS10);
+  top = newTop;
+  SREG = oldSREG;
+
+  return true;
+}
+
+void MotorPwm::end() {
+  uint8_t oldSREG = SREG;
+  cli();
+  // 8 bit phase correct PWM (mode 1), prescaler 64, as set up by the Arduino core
+  TCCR1B = 0;
+  TCCR1A = (TCCR1A & (_BV(COM1A1) | _BV(COM1A0) | _BV(COM1B1) | _BV(COM1B0))) | _BV(WGM10);
+  TCCR1B = _BV(CS11) | _BV(CS10);
+  top = 0;
+  SREG = oldSREG;
+
+  rc::Timer1Arbiter::release(rc::Timer1Arbiter::Client_Motor);
+}
+
+bool MotorPwm::isActive() {
+  return top != 0;
+}
+
+uint16_t MotorPwm::getTop() {
+  return top;
+}
+
+uint32_t MotorPwm::getFrequency() {
+  return top == 0 ? 0 : frequencyFor(top);
+}
+
+uint16_t MotorPwm::topFor(uint32_t frequency) {
+  if (frequency == 0) {
+    return 0xFFFF;
+  }
+  const uint32_t steps = F_CPU / 2 / frequency;
+  return steps < MinTop ? MinTop : (steps > 0xFFFF ? 0xFFFF : steps);
+}
+
+uint32_t MotorPwm::frequencyFor(uint16_t steps) {
+  return F_CPU / 2 / (steps < MinTop ? MinTop : steps);
+}
@@ -0,0 +1,43 @@
+#ifndef MOTOR_PWM_H
+#define MOTOR_PWM_H
+
+#include <stdint.h>
+
+// High frequency motor PWM on Timer1 (OC1A = pin 9, OC1B = pin 10).
+//
+// By default the two tracks run on whatever timer analogWrite() picks, e.g.
+// ~976 Hz on pin 6 (Timer0) and ~490 Hz on pin 9 (Timer1). begin() switches
+// Timer1 to phase correct PWM with ICR1 as TOP and no prescaler, so both
+// compare outputs share one frequency:
+//
+//   frequency = F_CPU / (2 * top), top = number of duty steps
+//
+// At 16 MHz that gives 20 kHz with 400 steps, 8 kHz with 1000 steps and
+// 4 kHz with 2000 steps; higher frequencies cost resolution.
+//
+// Timer1 can only have one mode: rc::Timer1 users (ServoIn, ServoOut, PPMIn,
+// PPMOut) need it as a free running 0.5 us time base. begin() claims the
+// timer through rc::Timer1Arbiter and refuses if one of those is running;
+// they are refused in turn while MotorPwm is active.
+class MotorPwm {
+  public:
+    static const uint16_t MinTop = 255; // at least the 8 bit resolution of the motor drivers
+
+    // returns false and leaves Timer1 alone if it is in use
+    static bool begin(uint32_t frequency);
+    // back to the Arduino default, 8 bit phase correct PWM with prescaler 64
+    static void end();
+    static bool isActive();
+
+    static uint16_t getTop();
+    static uint32_t getFrequency();
+
+    // resolution / frequency trade-off
+    static uint16_t topFor(uint32_t frequency);
+    static uint32_t frequencyFor(uint16_t top);
+
+  private:
+    static uint16_t top;
+};
+
+#endif
@@ -0,0 +1,128 @@
+#include <Arduino.h>
+#include <IsrProfiler.h>
+#include "scheduler.h"
+
+volatile uint8_t Scheduler::periodMs = 10;
+volatile uint8_t Scheduler::countdown = 10;
+volatile bool Scheduler::pending = false;
+volatile uint32_t Scheduler::tickTime = 0;
+volatile uint32_t Scheduler::ticks = 0;
+volatile uint16_t Scheduler::overruns = 0;
+uint16_t Scheduler::minLatency = 0xFFFF;
+uint16_t Scheduler::maxLatency = 0;
+
+void Scheduler::begin(uint16_t rateHz) {
+  const uint8_t period = 1000 / constrain(rateHz, 4, 1000);
+
+  uint8_t oldSREG = SREG;
+  cli();
+  periodMs = period;
+  countdown = period;
+  pending = false;
+
+  // CTC mode, prescaler 64: 16 MHz / 64 / 250 = 1 kHz
+  TCCR2A = _BV(WGM21);
+  TCCR2B = _BV(CS22);
+  TCNT2 = 0;
+  OCR2A = (F_CPU / 64 / 1000) - 1;
+  TIFR2 = _BV(OCF2A);
+  TIMSK2 = _BV(OCIE2A);
+  SREG = oldSREG;
+
+  resetStatistics();
+}
+
+bool Scheduler::due() {
+  if (!pending) {
+    return false;
+  }
+
+  uint8_t oldSREG = SREG;
+  cli();
+  const uint32_t tick = tickTime;
+  pending = false;
+  SREG = oldSREG;
+
+  const uint32_t elapsed = micros() - tick;
+  const uint16_t latency = elapsed > 0xFFFF ? 0xFFFF : elapsed;
+  if (latency < minLatency) {
+    minLatency = latency;
+  }
+  if (latency > maxLatency) {
+    maxLatency = latency;
+  }
+  return true;
+}
+
+uint32_t Scheduler::getTicks() {
+  uint8_t oldSREG = SREG;
+  cli();
+  const uint32_t copy = ticks;
+  SREG = oldSREG;
+  return copy;
+}
+
+uint16_t Scheduler::getOverruns() {
+  uint8_t oldSREG = SREG;
+  cli();
+  const uint16_t copy = overruns;
+  SREG = oldSREG;
+  return copy;
+}
+
+uint16_t Scheduler::getMinLatency() {
+  return minLatency;
+}
+
+uint16_t Scheduler::getMaxLatency() {
+  return maxLatency;
+}
+
+uint16_t Scheduler::getJitter() {
+  return maxLatency >= minLatency ? maxLatency - minLatency : 0;
+}
+
+void Scheduler::resetStatistics() {
+  uint8_t oldSREG = SREG;
+  cli();
+  ticks = 0;
+  overruns = 0;
+  SREG = oldSREG;
+  minLatency = 0xFFFF;
+  maxLatency = 0;
+}
+
+void Scheduler::print(Print& output) {
+  output.print("ticks=");
+  output.print(getTicks());
+  output.print(" overruns=");
+  output.print(getOverruns());
+  output.print(" latency=");
+  output.print(maxLatency >= minLatency ? minLatency : 0);
+  output.print('/');
+  output.print(maxLatency);
+  output.print(" jitter=");
+  output.println(getJitter());
+}
+
+void Scheduler::onTimer() {
+  if (--countdown != 0) {
+    return;
+  }
+  countdown = periodMs;
+
+  if (pending) {
+    // the previous control step has not even started yet
+    ++overruns;
+  }
+  tickTime = micros();
+  ++ticks;
+  pending = true;
+}
+
+ISR(TIMER2_COMPA_vect) {
+  // CTC restarts TCNT2 at the compare match, so it counts the latency (prescaler 64)
+  ISR_PROFILE_BEGIN(TCNT2 * 64 / (F_CPU / 1000000L));
+  Scheduler::onTimer();
+  ISR_PROFILE_END(Vector_Timer2CompareA);
+}
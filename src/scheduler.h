@@ -0,0 +1,48 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+class Print;
+
+// Fixed-rate control tick.
+//
+// Timer2 runs in CTC mode at 1 kHz and divides that down to the configured
+// control rate. The ISR only flags the tick, the control step itself runs in
+// loop() as soon as due() returns true, so the time between two control steps
+// is bounded by the tick period instead of by receiver pulse arrival.
+//
+// Timer2 is no longer available for analogWrite() on pins 3 / 11 or tone().
+class Scheduler {
+  public:
+    // rateHz should divide 1000 (e.g. 50, 100, 200 Hz)
+    static void begin(uint16_t rateHz);
+
+    // true once per tick, records the tick-to-step latency
+    static bool due();
+
+    static uint32_t getTicks();
+    // ticks that fired while the previous one was still pending
+    static uint16_t getOverruns();
+    // latency from tick to the start of the control step, in microseconds
+    static uint16_t getMinLatency();
+    static uint16_t getMaxLatency();
+    static uint16_t getJitter();
+    static void resetStatistics();
+    // ticks, overruns and min / max latency as one line of text
+    static void print(Print& output);
+
+    static void onTimer();
+
+  private:
+    static volatile uint8_t periodMs;
+    static volatile uint8_t countdown;
+    static volatile bool pending;
+    static volatile uint32_t tickTime;
+    static volatile uint32_t ticks;
+    static volatile uint16_t overruns;
+    static uint16_t minLatency;
+    static uint16_t maxLatency;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#include <Arduino.h>
+#include <string.h>
+#include "telemetry.h"
+
+TelemetryRecord Telemetry::records[Telemetry::Capacity];
+volatile uint8_t Telemetry::head = 0;
+volatile uint8_t Telemetry::tail = 0;
+uint8_t Telemetry::sequence = 0;
+uint8_t Telemetry::droppedSinceLast = 0;
+uint16_t Telemetry::dropped = 0;
+uint8_t Telemetry::frame[Telemetry::FrameSize];
+uint8_t Telemetry::framePos = Telemetry::FrameSize;
+
+bool Telemetry::push(const TelemetryRecord& record) {
+  const uint8_t next = (head + 1) & (Capacity - 1);
+  if (next == tail) {
+    ++dropped;
+    if (droppedSinceLast < 0xFF) {
+      ++droppedSinceLast;
+    }
+    return false;
+  }
+
+  records[head] = record;
+  head = next;
+  return true;
+}
+
+void Telemetry::drain() {
+  int room = Serial.availableForWrite();
+
+  while (room > 0) {
+    if (framePos == FrameSize) {
+      // current frame is out, encode the next record
+      if (tail == head) {
+        return;
+      }
+
+      frame[0] = 0xA5;
+      frame[1] = 0x5A;
+      frame[2] = sequence++;
+      frame[3] = droppedSinceLast;
+      droppedSinceLast = 0;
+      memcpy(&frame[4], &records[tail], sizeof(TelemetryRecord));
+      tail = (tail + 1) & (Capacity - 1);
+
+      uint8_t checksum = 0;
+      for (uint8_t i = 2; i < FrameSize - 1; ++i) {
+        checksum ^= frame[i];
+      }
+      frame[FrameSize - 1] = checksum;
+      framePos = 0;
+    }
+
+    uint8_t count = FrameSize - framePos;
+    if (count > room) {
+      count = room;
+    }
+    Serial.write(&frame[framePos], count);
+    framePos += count;
+    room -= count;
+  }
+}
+
+bool Telemetry::isBetweenFrames() {
+  return framePos == FrameSize;
+}
+
+uint16_t Telemetry::getDropped() {
+  return dropped;
+}
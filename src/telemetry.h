@@ -0,0 +1,59 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+// One control step, as sent over the serial link.
+struct TelemetryRecord {
+  uint32_t timestamp; // micros() at the start of the control step
+  uint16_t throttlePulse; // raw receiver pulse widths in microseconds
+  uint16_t steeringPulse;
+  int16_t left; // mixed track values, range [-256 - 256]
+  int16_t right;
+  uint8_t dutyA; // values written to the motor PWM pins
+  uint8_t dutyB;
+  uint8_t flags; // TELEMETRY_FLAG_*
+} __attribute__((packed));
+
+#define TELEMETRY_FLAG_A_BACKWARD 0x01
+#define TELEMETRY_FLAG_B_BACKWARD 0x02
+#define TELEMETRY_FLAG_TIMER1_CONFLICT 0x04 // rc::Timer1Arbiter refused a Timer1 user
+
+// Binary telemetry that never blocks the control loop.
+//
+// push() copies a record into a single producer / single consumer ring
+// buffer, or counts it as dropped when the buffer is full. drain() hands
+// queued bytes to Serial only as long as the hardware TX buffer has room, so
+// call it when there is nothing else to do.
+//
+// Frame layout (little endian), decoded by tools/decode_telemetry.py:
+//   0xA5 0x5A | sequence | dropped | TelemetryRecord | xor of sequence..record
+class Telemetry {
+  public:
+    static const uint8_t Capacity = 8; // records, power of two
+
+    static bool push(const TelemetryRecord& record);
+    static void drain();
+
+    // true when no frame is partially sent, so other output can't split one
+    static bool isBetweenFrames();
+
+    // records dropped because the buffer was full
+    static uint16_t getDropped();
+
+  private:
+    static const uint8_t FrameSize = 2 + 1 + 1 + sizeof(TelemetryRecord) + 1;
+
+    static TelemetryRecord records[Capacity];
+    static volatile uint8_t head; // written by push() only
+    static volatile uint8_t tail; // written by drain() only
+
+    static uint8_t sequence;
+    static uint8_t droppedSinceLast;
+    static uint16_t dropped;
+
+    static uint8_t frame[FrameSize];
+    static uint8_t framePos;
+};
+
+#endif
@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+"""Decode the binary telemetry stream of the RC Tank firmware (DEBUG builds).
+
+Reads frames as written by Telemetry::drain() (src/telemetry.cpp) from a
+serial port or a capture file and prints them as CSV.
+
+  python tools/decode_telemetry.py /dev/ttyUSB0          # live until Ctrl-C, needs pyserial
+  python tools/decode_telemetry.py capture.bin > log.csv # recorded stream
+"""
+
+import struct
+import sys
+
+SYNC = b'\xa5\x5a'
+# sequence, dropped, timestamp, throttle, steering, left, right, dutyA, dutyB, flags
+FRAME = struct.Struct('<BBIHHhhBBB')
+FRAME_SIZE = len(SYNC) + FRAME.size + 1
+
+FLAG_A_BACKWARD = 0x01
+FLAG_B_BACKWARD = 0x02
+FLAG_TIMER1_CONFLICT = 0x04
+
+COLUMNS = ('seq', 'dropped', 'timestamp_us', 'throttle_us', 'steering_us',
+           'left', 'right', 'duty_a', 'duty_b', 'a_backward', 'b_backward',
+           'timer1_conflict')
+
+
+def frames(stream, live=False):
+    """Yields decoded frames, resynchronizes on garbage and bad checksums.
+
+    An empty read ends a file or stdin. On a live port it is just a read
+    timeout (receiver or transmitter off), keep waiting for data.
+    """
+    buf = b''
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            if live:
+                continue
+            return
+        buf += chunk
+        while True:
+            start = buf.find(SYNC)
+            if start < 0:
+                buf = buf[-1:]
+                break
+            if len(buf) - start < FRAME_SIZE:
+                buf = buf[start:]
+                break
+            payload = buf[start + len(SYNC):start + FRAME_SIZE - 1]
+            checksum = 0
+            for byte in bytearray(payload):
+                checksum ^= byte
+            if checksum != bytearray(buf[start + FRAME_SIZE - 1:start + FRAME_SIZE])[0]:
+                buf = buf[start + 1:]
+                continue
+            buf = buf[start + FRAME_SIZE:]
+            yield FRAME.unpack(payload)
+
+
+def open_source(name):
+    """Returns the stream and whether it is a live serial port."""
+    if name == '-':
+        return getattr(sys.stdin, 'buffer', sys.stdin), False
+    if name.startswith('/dev/') or name.upper().startswith('COM'):
+        import serial
+        return serial.Serial(name, 115200, timeout=1), True
+    return open(name, 'rb'), False
+
+
+def main(argv):
+    if len(argv) != 2:
+        sys.stderr.write(__doc__)
+        return 1
+
+    print(','.join(COLUMNS))
+    last_seq = None
+    lost = 0
+    dropped = 0
+    stream, live = open_source(argv[1])
+    try:
+        for seq, drop, stamp, thr, steer, left, right, duty_a, duty_b, flags in frames(stream, live):
+            if last_seq is not None:
+                lost += (seq - last_seq - 1) & 0xFF
+            last_seq = seq
+            dropped += drop
+            print(','.join(str(v) for v in (seq, drop, stamp, thr, steer, left, right, duty_a, duty_b,
+                                            int(bool(flags & FLAG_A_BACKWARD)),
+                                            int(bool(flags & FLAG_B_BACKWARD)),
+                                            int(bool(flags & FLAG_TIMER1_CONFLICT)))))
+    except KeyboardInterrupt:
+        pass  # a live port only ends with Ctrl-C
+
+    sys.stderr.write('records dropped on target: %d, frames lost on the link: %d\n' % (dropped, lost))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))